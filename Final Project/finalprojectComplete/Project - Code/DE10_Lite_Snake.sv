@@ -1,4 +1,17 @@
-module DE10_Lite_Snake(
+module DE10_Lite_Snake #(
+    // 640x480, 800x600, 1024x768 or 1280x720; see snake_pkg
+    parameter snake_pkg::video_mode_sel_t VIDEO_MODE = snake_pkg::VIDEO_640X480,
+    parameter [15:0] LFSR_SEED = 16'hACE1,           // Apple sequence seed
+    // 1: play in a WORLD_WIDTH x WORLD_HEIGHT world in SDRAM (snake_world)
+    // behind a scrolling viewport; 0: the one-screen game (snake_game)
+    parameter WORLD_MODE = 0,
+    parameter WORLD_WIDTH = 1024,
+    parameter WORLD_HEIGHT = 1024,
+    // Simulation only: divides the debounce time and, in snake_game and
+    // snake_world, the frames per move. Traces and the C++ model must be
+    // run with the same factor.
+    parameter SIM_SPEEDUP = 1
+)(
     ///////// CLOCK /////////
     input logic           ADC_CLK_10,
     input logic           MAX10_CLK1_50,
@@ -26,7 +39,20 @@ module DE10_Lite_Snake(
     output logic [3:0]    VGA_G,
     output logic [3:0]    VGA_B,
     output logic          VGA_HS,
-    output logic          VGA_VS
+    output logic          VGA_VS,
+
+    ///////// SDRAM /////////
+    output logic [12:0]   DRAM_ADDR,
+    output logic [1:0]    DRAM_BA,
+    output logic          DRAM_CAS_N,
+    output logic          DRAM_CKE,
+    output logic          DRAM_CLK,
+    output logic          DRAM_CS_N,
+    inout  wire  [15:0]   DRAM_DQ,
+    output logic          DRAM_LDQM,
+    output logic          DRAM_RAS_N,
+    output logic          DRAM_UDQM,
+    output logic          DRAM_WE_N
 );
 
     // Debounced key signals
@@ -38,11 +64,27 @@ module DE10_Lite_Snake(
 	 logic [9:0] score;
 	 logic [3:0] bcd_hundreds, bcd_tens, bcd_units;
 	 
-	 always_comb begin
-        bcd_units = score % 10;          // Units digit
-        bcd_tens = (score / 10) % 10;    // Tens digit
-        bcd_hundreds = (score / 100) % 10; // Hundreds digit
-    end
+	 // Turn latency (clk cycles from key pulse to head move)
+	 logic [31:0] turn_lat_min, turn_lat_max, turn_lat_avg, turn_lat_shown;
+	 logic [7:0] turns_dropped;
+	 
+	 // Performance counter shown on the HEX displays (see perf_counters)
+	 logic [31:0] perf_readdata;
+	 
+	 // Score digits (common/bin2bcd.sv): converted one bit per clock, over
+	 // and over, so no divider is needed
+    bin2bcd #(
+        .WIDTH(10),
+        .DIGITS(3)
+    ) score_bcd (
+        .clk(MAX10_CLK1_50),
+        .reset_n(SW[0]),
+        .start(1'b1),
+        .bin(score),
+        .busy(),
+        .valid(),
+        .bcd({bcd_hundreds, bcd_tens, bcd_units})
+    );
 	 
 	     // Function to convert BCD digit to 7-segment (active-low)
     function logic [7:0] bcd_to_seg(input [3:0] bcd);
@@ -61,62 +103,163 @@ module DE10_Lite_Snake(
         endcase
     endfunction
 	 
+    // Function to convert a hex digit to 7-segment (active-low)
+    function logic [7:0] hex_to_seg(input [3:0] hex);
+        case (hex)
+            4'hA: hex_to_seg = 8'b10001000; // A
+            4'hB: hex_to_seg = 8'b10000011; // b
+            4'hC: hex_to_seg = 8'b11000110; // C
+            4'hD: hex_to_seg = 8'b10100001; // d
+            4'hE: hex_to_seg = 8'b10000110; // E
+            4'hF: hex_to_seg = 8'b10001110; // F
+            default: hex_to_seg = bcd_to_seg(hex);
+        endcase
+    endfunction
+	 
     // Synchronize reset
     always_ff @(posedge MAX10_CLK1_50) begin
         rst_sync <= ~SW[0];  // Active-high synchronized reset
     end
 	 
-    // Debounce KEY[0]
-    button_debounce db_key0 (
+    // Debounce KEY[1:0] (common/debouncer.sv): rising-edge pulses for
+    // direction control, levels for the LEDs
+    debouncer #(
+        .N(2),
+        .SIM_SPEEDUP(SIM_SPEEDUP)
+    ) db_keys (
         .clk(MAX10_CLK1_50),
         .rst(rst_sync),
-        .button(~KEY[0]),     // Invert active-low KEY[0]
-        .pulse(key0_pulse),   // For direction control
-        .stable(key0_stable)  // For LED
-    );
-
-    // Debounce KEY[1]
-    button_debounce db_key1 (
-        .clk(MAX10_CLK1_50),
-        .rst(rst_sync),
-        .button(~KEY[1]),     // Invert active-low KEY[1]
-        .pulse(key1_pulse),   // For direction control
-        .stable(key1_stable)  // For LED
+        .in(~KEY),                         // Invert active-low KEYs
+        .level({key1_stable, key0_stable}),
+        .rise({key1_pulse, key0_pulse}),
+        .fall()
     );
 
     // Connect to LEDs (LEDR[1] and LEDR[2])
     assign LEDR[1] = key0_stable;  // KEY[0] pressed → LEDR[1] on
     assign LEDR[2] = key1_stable;  // KEY[1] pressed → LEDR[2] on
 	 
-	 // Turn off all HEX displays (active low)
-    assign HEX0 = 8'hFF;
-    assign HEX1 = 8'hFF;
-    assign HEX2 = 8'hFF;
+	 // Turn latency on HEX2-HEX0 in hex, in units of 2^16 cycles (1.31 ms):
+	 // SW[9:8] = 01 min, 10 max, 11 average, 00 blank
+    always_comb begin
+        case (SW[9:8])
+            2'b01:   turn_lat_shown = turn_lat_min;
+            2'b10:   turn_lat_shown = turn_lat_max;
+            default: turn_lat_shown = turn_lat_avg;
+        endcase
+    end
 	 
-    assign HEX3 = bcd_to_seg(bcd_units); // Hundreds place
-    assign HEX4 = bcd_to_seg(bcd_tens);     // Tens place
-    assign HEX5 = bcd_to_seg(bcd_hundreds);
+	 // SW[7] up replaces all of it with performance counter SW[6:4] (low 24
+	 // bits, in hex): 0 frames, 1 moves, 2 apples, 3 collision checks,
+	 // 4 worst tick to commit cycles, 5 dropped turns, 6 last tick to commit
+    always_comb begin
+        if (SW[7]) begin
+            HEX0 = hex_to_seg(perf_readdata[3:0]);
+            HEX1 = hex_to_seg(perf_readdata[7:4]);
+            HEX2 = hex_to_seg(perf_readdata[11:8]);
+            HEX3 = hex_to_seg(perf_readdata[15:12]);
+            HEX4 = hex_to_seg(perf_readdata[19:16]);
+            HEX5 = hex_to_seg(perf_readdata[23:20]);
+        end else begin
+            HEX0 = (SW[9:8] == 2'b00) ? 8'hFF : hex_to_seg(turn_lat_shown[19:16]);
+            HEX1 = (SW[9:8] == 2'b00) ? 8'hFF : hex_to_seg(turn_lat_shown[23:20]);
+            HEX2 = (SW[9:8] == 2'b00) ? 8'hFF : hex_to_seg(turn_lat_shown[27:24]);
+            HEX3 = bcd_to_seg(bcd_units);     // Units place
+            HEX4 = bcd_to_seg(bcd_tens);      // Tens place
+            HEX5 = bcd_to_seg(bcd_hundreds);  // Hundreds place
+        end
+    end
 	 
     // Connect the Snake Game module to the top-level module
-    snake_game snake_inst(
-        .clk(MAX10_CLK1_50),      // Use the 50MHz clock
-        .reset_n(SW[0]),          // SW up is on, down off/reset
-        .KEY({key1_pulse, key0_pulse}), // Direction control keys
-        .SW(SW),                  // Switches for border visibility
-        .VGA_R(VGA_R),            // VGA Red channel
-        .VGA_G(VGA_G),            // VGA Green channel
-        .VGA_B(VGA_B),            // VGA Blue channel
-        .VGA_HS(VGA_HS),          // Horizontal sync
-        .VGA_VS(VGA_VS),           // Vertical sync
-		  .score(score)
-    );
+    generate
+        if (WORLD_MODE) begin : world_mode
+            snake_world #(
+                .VIDEO_MODE(VIDEO_MODE),
+                .WORLD_WIDTH(WORLD_WIDTH),
+                .WORLD_HEIGHT(WORLD_HEIGHT),
+                .LFSR_SEED(LFSR_SEED),
+                .SIM_SPEEDUP(SIM_SPEEDUP)
+            ) snake_inst(
+                .clk(MAX10_CLK1_50),      // Use the 50MHz clock
+                .reset_n(SW[0]),          // SW up is on, down off/reset
+                .KEY({key1_pulse, key0_pulse}), // Direction control keys
+                .SW(SW),                  // Switches for border visibility
+                .VGA_R(VGA_R),            // VGA Red channel
+                .VGA_G(VGA_G),            // VGA Green channel
+                .VGA_B(VGA_B),            // VGA Blue channel
+                .VGA_HS(VGA_HS),          // Horizontal sync
+                .VGA_VS(VGA_VS),          // Vertical sync
+                .score(score),
+                .turn_lat_min(turn_lat_min),
+                .turn_lat_max(turn_lat_max),
+                .turn_lat_avg(turn_lat_avg),
+                .turns_dropped(turns_dropped),
+                .perf_address(SW[6:4]),
+                .perf_read(1'b1),
+                .perf_readdata(perf_readdata),
+                .perf_write(1'b0),
+                .perf_writedata(32'b0),
+                .DRAM_ADDR(DRAM_ADDR),
+                .DRAM_BA(DRAM_BA),
+                .DRAM_CAS_N(DRAM_CAS_N),
+                .DRAM_CKE(DRAM_CKE),
+                .DRAM_CLK(DRAM_CLK),
+                .DRAM_CS_N(DRAM_CS_N),
+                .DRAM_DQ(DRAM_DQ),
+                .DRAM_LDQM(DRAM_LDQM),
+                .DRAM_RAS_N(DRAM_RAS_N),
+                .DRAM_UDQM(DRAM_UDQM),
+                .DRAM_WE_N(DRAM_WE_N)
+            );
+        end else begin : grid_mode
+            snake_game #(
+                .VIDEO_MODE(VIDEO_MODE),
+                .LFSR_SEED(LFSR_SEED),
+                .SIM_SPEEDUP(SIM_SPEEDUP)
+            ) snake_inst(
+                .clk(MAX10_CLK1_50),      // Use the 50MHz clock
+                .reset_n(SW[0]),          // SW up is on, down off/reset
+                .KEY({key1_pulse, key0_pulse}), // Direction control keys
+                .SW(SW),                  // Switches for border visibility
+                .VGA_R(VGA_R),            // VGA Red channel
+                .VGA_G(VGA_G),            // VGA Green channel
+                .VGA_B(VGA_B),            // VGA Blue channel
+                .VGA_HS(VGA_HS),          // Horizontal sync
+                .VGA_VS(VGA_VS),          // Vertical sync
+                .score(score),
+                .turn_lat_min(turn_lat_min),
+                .turn_lat_max(turn_lat_max),
+                .turn_lat_avg(turn_lat_avg),
+                .turns_dropped(turns_dropped),
+                .perf_address(SW[6:4]),
+                .perf_read(1'b1),
+                .perf_readdata(perf_readdata),
+                .perf_write(1'b0),
+                .perf_writedata(32'b0)
+            );
+            
+            // SDRAM unused: deselected, clock stopped
+            assign DRAM_ADDR = 13'b0;
+            assign DRAM_BA = 2'b0;
+            assign DRAM_CAS_N = 1'b1;
+            assign DRAM_CKE = 1'b0;
+            assign DRAM_CLK = 1'b0;
+            assign DRAM_CS_N = 1'b1;
+            assign DRAM_DQ = 16'hzzzz;
+            assign DRAM_LDQM = 1'b1;
+            assign DRAM_RAS_N = 1'b1;
+            assign DRAM_UDQM = 1'b1;
+            assign DRAM_WE_N = 1'b1;
+        end
+    endgenerate
     
     // Display the border status on LEDR[0]
     assign LEDR[0] = SW[0];
     
-
+    // SW[1] runs the snake on autopilot at top speed; shown on LEDR[3]
+    assign LEDR[3] = SW[1];
     
-    // Turn off unused LEDs
-    assign LEDR[9:3] = 9'b0;
+    // Dropped turns (low bits) on LEDR[9:4]
+    assign LEDR[9:4] = turns_dropped[5:0];
 
 endmodule
\ No newline at end of file
@@ -0,0 +1,188 @@
+// Apple placement engine: picks a uniformly random free cell by rank/select
+// over the occupancy bitmap, so the apple can never land on the snake.
+//
+//   S_COUNT  - one row per cycle: popcount the row's free cells and record
+//              the running prefix sum of free cells above it
+//   S_SCALE  - scale the random word to a rank k in [0, total) with a
+//              multiply (no divider): k = (rand * total) >> 16, which is
+//              uniform to within one part in 2^16 / total
+//   S_ROW    - prefix search: the row holding rank k is the number of rows
+//              whose prefix sum is <= k (all rows compared in parallel)
+//   S_RANK   - re-read that row and turn k into a rank within the row
+//   S_SELECT - binary search for the k-th free bit, one halving per cycle
+//
+// The latency does not depend on how full the board is: done pulses exactly
+// PLACE_LATENCY = GRID_HEIGHT + 3 + $clog2(GRID_WIDTH) cycles after start
+// (32 cycles for the 32x24 grid). found is low only when no free cell is
+// left. Only cells inside the BORDER_SIZE frame are candidates.
+module apple_placer #(
+    parameter GRID_WIDTH = 32,
+    parameter GRID_HEIGHT = 24,
+    parameter BORDER_SIZE = 1
+)(
+    input  logic clk,
+    input  logic reset_n,
+    input  logic start,                              // Begin a placement
+    input  logic [15:0] rand_in,                     // Random word, sampled on start
+
+    // Occupancy bitmap row read port (combinational)
+    output logic [$clog2(GRID_HEIGHT)-1:0] row_addr,
+    input  logic [GRID_WIDTH-1:0] row_occupied,
+
+    output logic busy,
+    output logic done,                               // Pulses when apple_x/apple_y are valid
+    output logic found,                              // A free cell was available
+    output logic [$clog2(GRID_WIDTH)-1:0] apple_x,
+    output logic [$clog2(GRID_HEIGHT)-1:0] apple_y
+);
+
+    localparam X_BITS = $clog2(GRID_WIDTH);
+    localparam Y_BITS = $clog2(GRID_HEIGHT);
+    localparam COUNT_BITS = $clog2(GRID_WIDTH * GRID_HEIGHT + 1);
+    localparam STEP_BITS = $clog2(X_BITS + 1);
+    localparam SEL_WIDTH = 1 << X_BITS;              // Search window, padded to a power of two
+    localparam PLACE_LATENCY = GRID_HEIGHT + 3 + X_BITS;
+
+    // Columns that may hold an apple
+    localparam logic [GRID_WIDTH-1:0] COL_MASK =
+        ({GRID_WIDTH{1'b1}} << BORDER_SIZE) & ({GRID_WIDTH{1'b1}} >> BORDER_SIZE);
+
+    typedef enum logic [2:0] {
+        S_IDLE,
+        S_COUNT,
+        S_SCALE,
+        S_ROW,
+        S_RANK,
+        S_SELECT
+    } place_state_t;
+
+    place_state_t state;
+    logic [Y_BITS-1:0] row;                          // Row being counted
+    logic [COUNT_BITS-1:0] running;                  // Free cells counted so far
+    logic [COUNT_BITS-1:0] prefix [0:GRID_HEIGHT-1]; // Free cells in rows above each row
+    logic [15:0] rnd;
+    logic [COUNT_BITS-1:0] rank;                     // Rank of the chosen free cell
+    logic [Y_BITS-1:0] row_sel;
+    logic [SEL_WIDTH-1:0] window;                    // Free cells still in the search window
+    logic [X_BITS-1:0] pos;                          // Left edge of the search window
+    logic [STEP_BITS-1:0] step;
+
+    function automatic logic [COUNT_BITS-1:0] popcount(input logic [SEL_WIDTH-1:0] bits);
+        popcount = 0;
+        for (int i = 0; i < SEL_WIDTH; i++)
+            popcount = popcount + COUNT_BITS'(bits[i]);
+    endfunction
+
+    // Free cells of the row currently on the read port
+    logic [GRID_WIDTH-1:0] row_free;
+    always_comb begin
+        if ({1'b0, row_addr} < (Y_BITS+1)'(BORDER_SIZE) ||
+            {1'b0, row_addr} >= (Y_BITS+1)'(GRID_HEIGHT - BORDER_SIZE))
+            row_free = '0;
+        else
+            row_free = ~row_occupied & COL_MASK;
+    end
+
+    assign row_addr = (state == S_RANK) ? row_sel : row;
+    assign busy = (state != S_IDLE);
+    assign apple_x = pos;
+    assign apple_y = row_sel;
+
+    // Prefix search: count the rows (after the first) that start at or
+    // before the chosen rank
+    logic [Y_BITS-1:0] rows_before;
+    always_comb begin
+        rows_before = 0;
+        for (int r = 1; r < GRID_HEIGHT; r++)
+            if (prefix[r] <= rank)
+                rows_before = rows_before + 1'b1;
+    end
+
+    // One halving step of the in-row select
+    logic [X_BITS-1:0] half;
+    logic [SEL_WIDTH-1:0] lower;
+    logic [COUNT_BITS-1:0] lower_count;
+    always_comb begin
+        half = X_BITS'(SEL_WIDTH >> (step + 1));
+        lower = window & ((SEL_WIDTH'(1) << half) - 1'b1);
+        lower_count = popcount(lower);
+    end
+
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n) begin
+            state <= S_IDLE;
+            row <= 0;
+            running <= 0;
+            for (int r = 0; r < GRID_HEIGHT; r++)
+                prefix[r] <= 0;
+            rnd <= 0;
+            rank <= 0;
+            row_sel <= 0;
+            window <= 0;
+            pos <= 0;
+            step <= 0;
+            done <= 0;
+            found <= 0;
+        end else begin
+            done <= 0;
+
+            case (state)
+                S_IDLE: begin
+                    if (start) begin
+                        row <= 0;
+                        running <= 0;
+                        rnd <= rand_in;
+                        state <= S_COUNT;
+                    end
+                end
+
+                S_COUNT: begin
+                    prefix[row] <= running;
+                    running <= running + popcount(SEL_WIDTH'(row_free));
+                    if (row == Y_BITS'(GRID_HEIGHT - 1))
+                        state <= S_SCALE;
+                    else
+                        row <= row + 1'b1;
+                end
+
+                S_SCALE: begin
+                    rank <= COUNT_BITS'((32'(rnd) * 32'(running)) >> 16);
+                    found <= (running != 0);
+                    state <= S_ROW;
+                end
+
+                S_ROW: begin
+                    row_sel <= rows_before;
+                    state <= S_RANK;
+                end
+
+                S_RANK: begin
+                    window <= SEL_WIDTH'(row_free);
+                    rank <= rank - prefix[row_sel];
+                    pos <= 0;
+                    step <= 0;
+                    state <= S_SELECT;
+                end
+
+                S_SELECT: begin
+                    if (rank < lower_count) begin
+                        window <= lower;
+                    end else begin
+                        window <= window >> half;
+                        pos <= pos + half;
+                        rank <= rank - lower_count;
+                    end
+                    if (step == STEP_BITS'(X_BITS - 1)) begin
+                        done <= 1;
+                        state <= S_IDLE;
+                    end else begin
+                        step <= step + 1'b1;
+                    end
+                end
+
+                default: state <= S_IDLE;
+            endcase
+        end
+    end
+
+endmodule
@@ -0,0 +1,167 @@
+// Rank/select apple placer against a reference model.
+//
+// Fills the occupancy map at random, from empty to nearly full, then with
+// exactly one free cell and with none, and checks every placement:
+//   - done comes exactly PLACE_LATENCY cycles after start
+//   - found is high exactly when a free cell exists
+//   - the chosen cell is free, inside the border, and is the rank-k free
+//     cell (row-major) for k = (rand * free cells) >> 16
+module apple_placer_tb #(
+    parameter GRID_WIDTH = 32,
+    parameter GRID_HEIGHT = 24,
+    parameter BORDER_SIZE = 1,
+    parameter TRIALS = 200                           // Placements per fill level
+)();
+    localparam X_BITS = $clog2(GRID_WIDTH);
+    localparam Y_BITS = $clog2(GRID_HEIGHT);
+    localparam PLACE_LATENCY = GRID_HEIGHT + 3 + X_BITS;
+
+    // Random fill levels, percent of cells occupied
+    localparam int FILLS [7] = '{0, 25, 50, 75, 90, 97, 99};
+
+    logic clk;
+    logic reset_n;
+    logic start;
+    logic [15:0] rand_in;
+    logic [Y_BITS-1:0] row_addr;
+    logic busy, done, found;
+    logic [X_BITS-1:0] apple_x;
+    logic [Y_BITS-1:0] apple_y;
+
+    // Occupancy map, read combinationally like snake_game's
+    logic [GRID_WIDTH-1:0] occupied [0:GRID_HEIGHT-1];
+
+    apple_placer #(
+        .GRID_WIDTH(GRID_WIDTH),
+        .GRID_HEIGHT(GRID_HEIGHT),
+        .BORDER_SIZE(BORDER_SIZE)
+    ) dut (
+        .clk(clk),
+        .reset_n(reset_n),
+        .start(start),
+        .rand_in(rand_in),
+        .row_addr(row_addr),
+        .row_occupied(occupied[row_addr]),
+        .busy(busy),
+        .done(done),
+        .found(found),
+        .apple_x(apple_x),
+        .apple_y(apple_y)
+    );
+
+    // Clock generation
+    initial begin
+        clk = 0;
+        forever #10 clk = ~clk; // 50MHz clock
+    end
+
+    function automatic bit candidate(input int x, input int y);
+        return x >= BORDER_SIZE && x < GRID_WIDTH - BORDER_SIZE &&
+               y >= BORDER_SIZE && y < GRID_HEIGHT - BORDER_SIZE;
+    endfunction
+
+    int placements = 0;
+    int errors = 0;
+
+    // One placement, checked against the model
+    task automatic place(input logic [15:0] rnd);
+        int total, k, ex, ey, latency;
+
+        total = 0;
+        for (int y = 0; y < GRID_HEIGHT; y++)
+            for (int x = 0; x < GRID_WIDTH; x++)
+                if (candidate(x, y) && !occupied[y][x])
+                    total++;
+
+        k = (int'(rnd) * total) >> 16;
+        ex = -1;
+        ey = -1;
+        for (int y = 0; y < GRID_HEIGHT && ey < 0; y++)
+            for (int x = 0; x < GRID_WIDTH; x++)
+                if (candidate(x, y) && !occupied[y][x]) begin
+                    if (k == 0) begin
+                        ex = x;
+                        ey = y;
+                        break;
+                    end
+                    k--;
+                end
+
+        @(negedge clk);
+        rand_in = rnd;
+        start = 1;
+        @(negedge clk);
+        start = 0;
+        latency = 0;
+        while (!done && latency < 4 * PLACE_LATENCY) begin
+            @(negedge clk);
+            latency++;
+        end
+
+        placements++;
+        if (latency != PLACE_LATENCY) begin
+            errors++;
+            $display("%0d free: done after %0d cycles, expected %0d", total, latency,
+                     PLACE_LATENCY);
+        end
+        if (found != (total != 0)) begin
+            errors++;
+            $display("%0d free: found=%b", total, found);
+        end
+        if (total != 0 && (apple_x != ex || apple_y != ey || occupied[apple_y][apple_x])) begin
+            errors++;
+            $display("%0d free, rand %h: chose (%0d, %0d)%s, expected (%0d, %0d)", total, rnd,
+                     apple_x, apple_y, occupied[apple_y][apple_x] ? " (occupied)" : "", ex, ey);
+        end
+    endtask
+
+    // Occupy each cell with probability percent / 100
+    task automatic fill(input int percent);
+        for (int y = 0; y < GRID_HEIGHT; y++)
+            for (int x = 0; x < GRID_WIDTH; x++)
+                occupied[y][x] = ($urandom_range(99) < percent);
+    endtask
+
+    // Test sequence
+    initial begin
+        reset_n = 0;
+        start = 0;
+        rand_in = 0;
+        fill(0);
+        repeat (4) @(posedge clk);
+        reset_n = 1;
+
+        // Random fills, up to nearly full
+        foreach (FILLS[i]) begin
+            for (int t = 0; t < TRIALS; t++) begin
+                fill(FILLS[i]);
+                place(16'($urandom));
+            end
+        end
+
+        // A single free cell, anywhere inside the border, with the extreme
+        // random words as well
+        for (int t = 0; t < TRIALS; t++) begin
+            int fx, fy;
+            fill(100);
+            fx = $urandom_range(GRID_WIDTH - 1 - BORDER_SIZE, BORDER_SIZE);
+            fy = $urandom_range(GRID_HEIGHT - 1 - BORDER_SIZE, BORDER_SIZE);
+            occupied[fy][fx] = 0;
+            place((t % 3 == 0) ? 16'h0000 : (t % 3 == 1) ? 16'hFFFF : 16'($urandom));
+        end
+
+        // Nothing free: only the border cells are clear
+        fill(100);
+        for (int y = 0; y < GRID_HEIGHT; y++)
+            for (int x = 0; x < GRID_WIDTH; x++)
+                if (!candidate(x, y))
+                    occupied[y][x] = 0;
+        place(16'h8000);
+
+        $display("apple_placer: %0d placements, %0d errors", placements, errors);
+        if (errors != 0)
+            $error("apple_placer_tb FAILED");
+        $finish;
+    end
+
+endmodule
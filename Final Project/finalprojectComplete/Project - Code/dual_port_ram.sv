@@ -0,0 +1,29 @@
+// Simple dual-port RAM: one write port, one registered read port.
+// Written so Quartus infers a single M9K block (separate clocks allowed,
+// so the same module works inside one clock domain or across two).
+// Read data appears one rd_clk cycle after rd_addr is presented.
+module dual_port_ram #(
+    parameter DATA_WIDTH = 8,
+    parameter ADDR_WIDTH = 10
+)(
+    input  logic                  wr_clk,
+    input  logic                  wr_en,
+    input  logic [ADDR_WIDTH-1:0] wr_addr,
+    input  logic [DATA_WIDTH-1:0] wr_data,
+    input  logic                  rd_clk,
+    input  logic [ADDR_WIDTH-1:0] rd_addr,
+    output logic [DATA_WIDTH-1:0] rd_data
+);
+
+    (* ramstyle = "M9K" *) logic [DATA_WIDTH-1:0] mem [0:(1<<ADDR_WIDTH)-1];
+
+    always_ff @(posedge wr_clk) begin
+        if (wr_en)
+            mem[wr_addr] <= wr_data;
+    end
+
+    always_ff @(posedge rd_clk) begin
+        rd_data <= mem[rd_addr];
+    end
+
+endmodule
@@ -0,0 +1,75 @@
+// 8x8 font ROM (M9K) for the text overlay: 128 ASCII codes, one pixel per
+// word, addressed {char, row, col}, so a glyph pixel needs no bit select
+// after the read. Only space, digits, capitals and ":-/" are drawn, in a
+// 5x7 face; every other code is blank. Read data appears one clock after
+// addr is presented.
+module font_rom (
+    input  logic clk,
+    input  logic [12:0] addr,                        // {char[6:0], row[2:0], col[2:0]}
+    output logic pixel
+);
+
+    // Glyph rows top to bottom, most significant byte first; bit 7 of a row
+    // is its leftmost pixel
+    function automatic logic [63:0] glyph(input logic [7:0] c);
+        case (c)
+            " ":  return 64'h0000000000000000;
+            "0":  return 64'h38444C5464443800;
+            "1":  return 64'h1030101010103800;
+            "2":  return 64'h3844040810207C00;
+            "3":  return 64'h7C08100804443800;
+            "4":  return 64'h081828487C080800;
+            "5":  return 64'h7C40780404443800;
+            "6":  return 64'h1820407844443800;
+            "7":  return 64'h7C04081020202000;
+            "8":  return 64'h3844443844443800;
+            "9":  return 64'h3844443C04083000;
+            "A":  return 64'h3844447C44444400;
+            "B":  return 64'h7844447844447800;
+            "C":  return 64'h3844404040443800;
+            "D":  return 64'h7048444444487000;
+            "E":  return 64'h7C40407840407C00;
+            "F":  return 64'h7C40407840404000;
+            "G":  return 64'h3844405C44443C00;
+            "H":  return 64'h4444447C44444400;
+            "I":  return 64'h3810101010103800;
+            "J":  return 64'h1C08080808483000;
+            "K":  return 64'h4448506050484400;
+            "L":  return 64'h4040404040407C00;
+            "M":  return 64'h446C545444444400;
+            "N":  return 64'h444464544C444400;
+            "O":  return 64'h3844444444443800;
+            "P":  return 64'h7844447840404000;
+            "Q":  return 64'h3844444454483400;
+            "R":  return 64'h7844447850484400;
+            "S":  return 64'h3C40403804047800;
+            "T":  return 64'h7C10101010101000;
+            "U":  return 64'h4444444444443800;
+            "V":  return 64'h4444444444281000;
+            "W":  return 64'h4444445454542800;
+            "X":  return 64'h4444281028444400;
+            "Y":  return 64'h4444281010101000;
+            "Z":  return 64'h7C04081020407C00;
+            ":":  return 64'h0010100010100000;
+            "-":  return 64'h0000007C00000000;
+            "/":  return 64'h0004081020400000;
+            default: return 64'h0000000000000000;
+        endcase
+    endfunction
+
+    (* romstyle = "M9K" *) logic rom [0:8191];
+
+    initial begin
+        for (int c = 0; c < 128; c++) begin
+            logic [63:0] bits;
+            bits = glyph(8'(c));
+            for (int i = 0; i < 64; i++)
+                rom[13'(c * 64 + i)] = bits[6'(63 - i)];
+        end
+    end
+
+    always_ff @(posedge clk) begin
+        pixel <= rom[addr];
+    end
+
+endmodule
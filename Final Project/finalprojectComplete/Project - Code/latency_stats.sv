@@ -0,0 +1,47 @@
+// Running statistics of a latency measured in clock cycles.
+// min/max/sum/count are exact, so simulation can compute the true mean as
+// sum / count; avg is an exponential moving average (weight 1/8 per
+// sample) that hardware can show without a divider.
+module latency_stats #(
+    parameter WIDTH = 32
+)(
+    input  logic clk,
+    input  logic reset_n,
+    input  logic sample_valid,
+    input  logic [WIDTH-1:0] sample,
+
+    output logic [WIDTH-1:0] min,                    // All ones until the first sample
+    output logic [WIDTH-1:0] max,
+    output logic [WIDTH-1:0] avg,
+    output logic [WIDTH+15:0] sum,
+    output logic [31:0] count
+);
+
+    // avg + (sample - avg) / 8, kept 3 bits wider so nothing wraps
+    logic [WIDTH+3:0] avg_next;
+    assign avg_next = (({4'b0, avg} << 3) - {4'b0, avg} + {4'b0, sample}) >> 3;
+
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n) begin
+            min <= '1;
+            max <= '0;
+            avg <= '0;
+            sum <= '0;
+            count <= '0;
+        end else if (sample_valid) begin
+            if (sample < min)
+                min <= sample;
+            if (sample > max)
+                max <= sample;
+            sum <= sum + (WIDTH+16)'(sample);
+            count <= count + 1;
+
+            // First sample seeds the average
+            if (count == 0)
+                avg <= sample;
+            else
+                avg <= avg_next[WIDTH-1:0];
+        end
+    end
+
+endmodule
@@ -0,0 +1,125 @@
+// Performance counters for the game engines, read through a small
+// Avalon-MM slave (32-bit words, read latency 1), the register interface a
+// JTAG UART or JTAG-to-Avalon bridge master would use. On the board the
+// top level reads the register picked by the switches onto the HEX
+// displays; in simulation perf_uart_model reads them out as text.
+//
+// Register map (word addresses):
+//   0 FRAMES      frame ticks (one per rendered frame)
+//   1 TICKS       moves started
+//   2 APPLES      apples eaten
+//   3 CHECKS      collision checks (one per game tick while running)
+//   4 COMMIT_MAX  worst cycles from a move's tick to its state commit
+//   5 DROPPED     turns lost to a full turn queue
+//   6 COMMIT_LAST cycles from the last move's tick to its commit
+//   7 CONTROL     reads PERF_ID; writing bit 0 clears every counter
+//
+// Counters wrap; COMMIT_* saturate. A move that never commits (it ended
+// the game) gives no commit sample.
+module perf_counters #(
+    parameter [31:0] PERF_ID = 32'h50455246         // "PERF"
+)(
+    input  logic clk,
+    input  logic reset_n,
+
+    // Events, one clk pulse each
+    input  logic frame,
+    input  logic move_start,
+    input  logic move_commit,
+    input  logic apple,
+    input  logic collision_check,
+    input  logic turn_drop,
+
+    // Avalon-MM slave
+    input  logic [2:0] avs_address,
+    input  logic avs_read,
+    output logic [31:0] avs_readdata,
+    input  logic avs_write,
+    input  logic [31:0] avs_writedata
+);
+
+    localparam REG_FRAMES = 3'd0;
+    localparam REG_TICKS = 3'd1;
+    localparam REG_APPLES = 3'd2;
+    localparam REG_CHECKS = 3'd3;
+    localparam REG_COMMIT_MAX = 3'd4;
+    localparam REG_DROPPED = 3'd5;
+    localparam REG_COMMIT_LAST = 3'd6;
+    localparam REG_CONTROL = 3'd7;
+
+    logic [31:0] frames, ticks, apples, checks, dropped;
+    logic [31:0] commit_max, commit_last;
+    logic [31:0] commit_timer;                       // Cycles since move_start
+    logic commit_armed;
+    logic clear;
+
+    assign clear = avs_write && avs_address == REG_CONTROL && avs_writedata[0];
+
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n) begin
+            frames <= 0;
+            ticks <= 0;
+            apples <= 0;
+            checks <= 0;
+            dropped <= 0;
+            commit_max <= 0;
+            commit_last <= 0;
+            commit_timer <= 0;
+            commit_armed <= 0;
+        end else if (clear) begin
+            frames <= 0;
+            ticks <= 0;
+            apples <= 0;
+            checks <= 0;
+            dropped <= 0;
+            commit_max <= 0;
+            commit_last <= 0;
+            commit_armed <= 0;
+        end else begin
+            if (frame)
+                frames <= frames + 1;
+            if (move_start)
+                ticks <= ticks + 1;
+            if (apple)
+                apples <= apples + 1;
+            if (collision_check)
+                checks <= checks + 1;
+            if (turn_drop)
+                dropped <= dropped + 1;
+
+            // Tick to commit, counted from the cycle after the tick
+            if (move_start) begin
+                commit_timer <= 1;
+                commit_armed <= 1;
+            end else if (commit_armed) begin
+                if (move_commit) begin
+                    commit_armed <= 0;
+                    commit_last <= commit_timer;
+                    if (commit_timer > commit_max)
+                        commit_max <= commit_timer;
+                end else if (commit_timer != '1) begin
+                    commit_timer <= commit_timer + 1;
+                end
+            end
+        end
+    end
+
+    // Read port
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n) begin
+            avs_readdata <= 0;
+        end else if (avs_read) begin
+            case (avs_address)
+                REG_FRAMES:      avs_readdata <= frames;
+                REG_TICKS:       avs_readdata <= ticks;
+                REG_APPLES:      avs_readdata <= apples;
+                REG_CHECKS:      avs_readdata <= checks;
+                REG_COMMIT_MAX:  avs_readdata <= commit_max;
+                REG_DROPPED:     avs_readdata <= dropped;
+                REG_COMMIT_LAST: avs_readdata <= commit_last;
+                default:         avs_readdata <= PERF_ID;
+            endcase
+        end
+    end
+
+endmodule
@@ -0,0 +1,56 @@
+// Stand-in for a JTAG UART link to the performance counters, for
+// simulation. It masters perf_counters' Avalon-MM port the way a JTAG
+// master on the board would, and prints what it reads as a text report in
+// the transcript instead of on a host terminal.
+//
+// Call from the testbench:
+//   uart.read_reg(addr, data)  - one Avalon read (read latency 1)
+//   uart.clear()               - write CONTROL bit 0
+//   uart.dump()                - read every register into uart.regs and
+//                                print one line
+module perf_uart_model (
+    input  logic clk,
+    output logic [2:0] avm_address,
+    output logic avm_read,
+    input  logic [31:0] avm_readdata,
+    output logic avm_write,
+    output logic [31:0] avm_writedata
+);
+
+    logic [31:0] regs [0:7];                         // Registers as last read by dump()
+
+    initial begin
+        avm_address = 3'd0;
+        avm_read = 1'b0;
+        avm_write = 1'b0;
+        avm_writedata = 32'd0;
+    end
+
+    task automatic read_reg(input logic [2:0] addr, output logic [31:0] data);
+        @(negedge clk);
+        avm_address = addr;
+        avm_read = 1'b1;
+        @(negedge clk);
+        avm_read = 1'b0;
+        data = avm_readdata;
+    endtask
+
+    task automatic clear();
+        @(negedge clk);
+        avm_address = 3'd7;
+        avm_writedata = 32'd1;
+        avm_write = 1'b1;
+        @(negedge clk);
+        avm_write = 1'b0;
+    endtask
+
+    task automatic dump();
+        for (int a = 0; a < 8; a++)
+            read_reg(3'(a), regs[a]);
+        if (regs[7] != 32'h50455246)
+            $error("perf_uart_model: CONTROL reads %h, not the PERF id", regs[7]);
+        $display("PERF frames=%0d ticks=%0d apples=%0d checks=%0d commit_max=%0d commit_last=%0d dropped=%0d",
+                 regs[0], regs[1], regs[2], regs[3], regs[4], regs[6], regs[5]);
+    endtask
+
+endmodule
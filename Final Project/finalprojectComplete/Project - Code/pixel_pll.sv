@@ -0,0 +1,61 @@
+// Pixel clock PLL for the VGA output.
+// Derives the pixel clock from the 50 MHz board clock as
+//   c0 = inclk0 * MULTIPLY_BY / DIVIDE_BY
+// on a dedicated PLL clock network, instead of a logic-generated clock.
+// Defaults give 25 MHz for 640x480 @ 60Hz.
+//
+// Verilator has no altpll model, so under VERILATOR c0 is a plain inclk0/2
+// toggle for every ratio. The game is frame-locked, so a simulation runs
+// the same game in any mode; only the frame rate in simulated time changes.
+module pixel_pll #(
+    parameter MULTIPLY_BY = 1,
+    parameter DIVIDE_BY = 2,
+    parameter INCLK_PERIOD_PS = 20000                // 50 MHz input
+)(
+    input  logic areset,
+    input  logic inclk0,
+    output logic c0,
+    output logic locked
+);
+
+`ifdef VERILATOR
+    logic [2:0] lock_count;
+
+    always_ff @(posedge inclk0 or posedge areset) begin
+        if (areset) begin
+            c0 <= 1'b0;
+            lock_count <= 0;
+        end else begin
+            c0 <= ~c0;
+            if (lock_count != 3'b111)
+                lock_count <= lock_count + 1'b1;
+        end
+    end
+
+    assign locked = (lock_count == 3'b111);
+`else
+    logic [4:0] pll_clk;
+
+    altpll #(
+        .bandwidth_type("AUTO"),
+        .clk0_divide_by(DIVIDE_BY),
+        .clk0_duty_cycle(50),
+        .clk0_multiply_by(MULTIPLY_BY),
+        .clk0_phase_shift("0"),
+        .inclk0_input_frequency(INCLK_PERIOD_PS),
+        .intended_device_family("MAX 10"),
+        .lpm_type("altpll"),
+        .operation_mode("NORMAL"),
+        .pll_type("AUTO"),
+        .width_clock(5)
+    ) altpll_component (
+        .areset(areset),
+        .inclk({1'b0, inclk0}),
+        .clk(pll_clk),
+        .locked(locked)
+    );
+
+    assign c0 = pll_clk[0];
+`endif
+
+endmodule
@@ -0,0 +1,241 @@
+// SDR SDRAM controller for the DE10-Lite's IS42S16320D (32M x 16, 4 banks,
+// 8192 rows of 1024 words).
+//
+// Runs on the 50 MHz system clock, with DRAM_CLK the inverted clock so the
+// SDRAM samples commands and write data half a cycle after they leave the
+// FPGA registers, and read data is captured on the next rising edge.
+//
+// Every access opens one row, runs, and closes it again with auto
+// precharge, so an access must stay within one row. Reads come in bursts
+// of 8 words (the mode register's burst length) issued back to back, so
+// len words stream out on consecutive cycles; a read should start on an
+// 8-word boundary, or its first burst wraps. Writes are single-word
+// (write burst mode off), one per cycle, with byte enables. Refresh is
+// issued every 7.8 us between accesses and goes ahead of a waiting request.
+//
+// User port: req/we/addr/len are taken in the cycle ack is high. A write
+// then takes wdata/wbe in every cycle wnext is high, len times; a read
+// returns its words on rdata with rvalid. The next access is only accepted
+// once the last read word has been handed over.
+module sdram_ctrl #(
+    parameter CLK_MHZ = 50,                          // clk frequency, for the datasheet timings
+    parameter CAS_LATENCY = 2                        // 2 or 3; 2 is fine below 100 MHz
+)(
+    input  logic clk,
+    input  logic reset_n,
+
+    // User port
+    output logic ready,                              // Power-up sequence done
+    input  logic req,
+    input  logic we,
+    input  logic [24:0] addr,                        // Word address {bank, row, col}
+    input  logic [10:0] len,                         // Words, 1 to 1024; reads round up to bursts of 8
+    output logic ack,
+    input  logic [15:0] wdata,
+    input  logic [1:0] wbe,                          // Byte enables of wdata
+    output logic wnext,                              // wdata/wbe go out this cycle
+    output logic [15:0] rdata,
+    output logic rvalid,
+
+    // SDRAM pins
+    output logic [12:0] DRAM_ADDR,
+    output logic [1:0]  DRAM_BA,
+    output logic        DRAM_CAS_N,
+    output logic        DRAM_CKE,
+    output logic        DRAM_CLK,
+    output logic        DRAM_CS_N,
+    inout  wire  [15:0] DRAM_DQ,
+    output logic        DRAM_LDQM,
+    output logic        DRAM_RAS_N,
+    output logic        DRAM_UDQM,
+    output logic        DRAM_WE_N
+);
+
+    // Datasheet timings (-7 speed grade, rounded up) in clk cycles
+    function automatic int cycles(input int ns);
+        return (ns * CLK_MHZ + 999) / 1000;
+    endfunction
+
+    localparam BURST = 8;
+    localparam T_INIT = cycles(200_000);             // Power-up wait
+    localparam T_REFI = cycles(7_800);               // 8192 refreshes per 64 ms
+    localparam T_RP = cycles(20);                    // Precharge to activate
+    localparam T_RCD = cycles(20);                   // Activate to read/write
+    localparam T_RC = cycles(70);                    // Refresh to anything, activate to activate
+    localparam T_MRD = 2;                            // Mode register to anything
+    localparam T_WR = 2;                             // Last write data to precharge
+    localparam RD_LAT = CAS_LATENCY + 1;             // Read command to captured data
+    localparam T_WR_DONE = (T_WR + T_RP > T_RC) ? T_WR + T_RP : T_RC;
+    localparam T_RD_DONE = BURST + RD_LAT + T_RP;
+    localparam INIT_REFRESHES = 8;
+    localparam WAIT_BITS = $clog2(T_INIT + 1);
+    localparam REFRESH_BITS = $clog2(T_REFI + 1);
+
+    // Burst length 8, sequential, single-word writes
+    localparam [12:0] MODE_REG = {3'b000, 1'b1, 2'b00, 3'(CAS_LATENCY), 1'b0, 3'b011};
+
+    // {CS_N, RAS_N, CAS_N, WE_N}
+    localparam [3:0] CMD_NOP       = 4'b0111;
+    localparam [3:0] CMD_ACTIVE    = 4'b0011;
+    localparam [3:0] CMD_READ      = 4'b0101;
+    localparam [3:0] CMD_WRITE     = 4'b0100;
+    localparam [3:0] CMD_PRECHARGE = 4'b0010;
+    localparam [3:0] CMD_REFRESH   = 4'b0001;
+    localparam [3:0] CMD_MODE      = 4'b0000;
+
+    typedef enum logic [2:0] {
+        S_INIT,
+        S_IDLE,
+        S_READ,
+        S_WRITE
+    } state_t;
+
+    state_t state;
+    logic [WAIT_BITS-1:0] wait_count;                // Cycles before the next command
+    logic [3:0] init_step;
+    logic [REFRESH_BITS-1:0] refresh_count;
+    logic refresh_due;
+
+    // Access being run
+    logic [9:0] col;
+    logic [10:0] words_left;
+
+    // Registered pins
+    logic [3:0] cmd;
+    logic [15:0] dq_out;
+    logic dq_oe;
+    logic [1:0] dqm;
+    logic [15:0] dq_in;
+    logic [RD_LAT:0] rd_pipe;                        // Read word slots on their way back
+    logic [2:0] burst_slots;                         // Slots still to mark for the current burst
+
+    assign {DRAM_CS_N, DRAM_RAS_N, DRAM_CAS_N, DRAM_WE_N} = cmd;
+    assign DRAM_CKE = 1'b1;
+    assign DRAM_CLK = ~clk;
+    assign DRAM_DQ = dq_oe ? dq_out : 16'hzzzz;
+    assign {DRAM_UDQM, DRAM_LDQM} = dqm;
+
+    assign ack = state == S_IDLE && wait_count == 0 && !refresh_due && req;
+    assign wnext = state == S_WRITE && wait_count == 0;
+    assign rdata = dq_in;
+    assign rvalid = rd_pipe[RD_LAT];
+
+    always_ff @(posedge clk) begin
+        dq_in <= DRAM_DQ;
+    end
+
+    // Refresh timer
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n) begin
+            refresh_count <= REFRESH_BITS'(T_REFI);
+            refresh_due <= 0;
+        end else if (state == S_IDLE && wait_count == 0 && refresh_due) begin
+            refresh_count <= REFRESH_BITS'(T_REFI);
+            refresh_due <= 0;
+        end else if (refresh_count != 0) begin
+            refresh_count <= refresh_count - 1'b1;
+        end else begin
+            refresh_due <= 1;
+        end
+    end
+
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n) begin
+            state <= S_INIT;
+            wait_count <= WAIT_BITS'(T_INIT);
+            init_step <= 0;
+            ready <= 0;
+            col <= 0;
+            words_left <= 0;
+            cmd <= CMD_NOP;
+            DRAM_ADDR <= 0;
+            DRAM_BA <= 0;
+            dq_out <= 0;
+            dq_oe <= 0;
+            dqm <= 2'b11;
+            rd_pipe <= 0;
+            burst_slots <= 0;
+        end else begin
+            cmd <= CMD_NOP;
+            dq_oe <= 0;
+            dqm <= 2'b00;
+            rd_pipe <= {rd_pipe[RD_LAT-1:0], burst_slots != 0};
+            if (burst_slots != 0)
+                burst_slots <= burst_slots - 1'b1;
+
+            if (wait_count != 0) begin
+                wait_count <= wait_count - 1'b1;
+            end else begin
+                case (state)
+                    S_INIT: begin
+                        // Precharge all, eight refreshes, then the mode register
+                        init_step <= init_step + 1'b1;
+                        if (init_step == 0) begin
+                            cmd <= CMD_PRECHARGE;
+                            DRAM_ADDR[10] <= 1'b1;
+                            wait_count <= WAIT_BITS'(T_RP - 1);
+                        end else if (init_step <= 4'(INIT_REFRESHES)) begin
+                            cmd <= CMD_REFRESH;
+                            wait_count <= WAIT_BITS'(T_RC - 1);
+                        end else begin
+                            cmd <= CMD_MODE;
+                            DRAM_BA <= 2'b00;
+                            DRAM_ADDR <= MODE_REG;
+                            wait_count <= WAIT_BITS'(T_MRD - 1);
+                            state <= S_IDLE;
+                            ready <= 1;
+                        end
+                    end
+
+                    S_IDLE: begin
+                        if (refresh_due) begin
+                            cmd <= CMD_REFRESH;
+                            wait_count <= WAIT_BITS'(T_RC - 1);
+                        end else if (req) begin
+                            cmd <= CMD_ACTIVE;
+                            {DRAM_BA, DRAM_ADDR} <= addr[24:10];
+                            col <= addr[9:0];
+                            words_left <= len;
+                            wait_count <= WAIT_BITS'(T_RCD - 1);
+                            state <= we ? S_WRITE : S_READ;
+                        end
+                    end
+
+                    S_READ: begin
+                        // One burst every BURST cycles; the last one closes the row
+                        cmd <= CMD_READ;
+                        DRAM_ADDR <= {2'b00, words_left <= 11'(BURST), col};
+                        rd_pipe[0] <= 1'b1;
+                        burst_slots <= 3'(BURST - 1);
+                        col <= col + 10'(BURST);
+                        if (words_left <= 11'(BURST)) begin
+                            wait_count <= WAIT_BITS'(T_RD_DONE - 1);
+                            state <= S_IDLE;
+                        end else begin
+                            words_left <= words_left - 11'(BURST);
+                            wait_count <= WAIT_BITS'(BURST - 1);
+                        end
+                    end
+
+                    S_WRITE: begin
+                        // One word per cycle; the last one closes the row
+                        cmd <= CMD_WRITE;
+                        DRAM_ADDR <= {2'b00, words_left == 1, col};
+                        dq_out <= wdata;
+                        dq_oe <= 1;
+                        dqm <= ~wbe;
+                        col <= col + 1'b1;
+                        words_left <= words_left - 1'b1;
+                        if (words_left == 1) begin
+                            wait_count <= WAIT_BITS'(T_WR_DONE - 1);
+                            state <= S_IDLE;
+                        end
+                    end
+                    
+                    default: state <= S_INIT;
+                endcase
+            end
+        end
+    end
+
+endmodule
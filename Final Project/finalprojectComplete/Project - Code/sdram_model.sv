@@ -0,0 +1,249 @@
+// Behavioral model of the DE10-Lite's IS42S16320D SDRAM, for simulation.
+//
+// Commands are taken on the rising edge of DRAM_CLK. Read data leaves
+// CAS latency edges after the READ and is held for one clock, and a new
+// READ cuts the running burst short, as on the real part. Writes honor
+// the byte masks and the mode register's write burst setting. Storage is
+// sparse, so only the words written cost memory; unwritten words read as X.
+//
+// Protocol errors are reported with $error and counted in errors: commands
+// to a closed bank or activates on an open one, tRCD/tRP/tRC/tMRD
+// violations, anything before the 200 us power-up wait or the mode
+// register, and refresh gaps longer than eight refresh intervals.
+module sdram_model #(
+    parameter CLK_MHZ = 50                           // DRAM_CLK frequency, for the timing checks
+)(
+    input  logic        clk,
+    input  logic        cke,
+    input  logic        cs_n,
+    input  logic        ras_n,
+    input  logic        cas_n,
+    input  logic        we_n,
+    input  logic [1:0]  ba,
+    input  logic [12:0] addr,
+    input  logic [1:0]  dqm,                         // {UDQM, LDQM}
+    inout  wire  [15:0] dq
+);
+
+    function automatic int cycles(input int ns);
+        return (ns * CLK_MHZ + 999) / 1000;
+    endfunction
+
+    localparam T_INIT = cycles(200_000);
+    localparam T_REFI = cycles(7_800);
+    localparam T_RP = cycles(15);
+    localparam T_RCD = cycles(15);
+    localparam T_RC = cycles(60);
+    localparam T_MRD = 2;
+    localparam MAX_CL = 3;
+
+    logic [15:0] mem [int unsigned];
+
+    // Mode register
+    logic mode_set;
+    int cas_latency;
+    int burst_len;
+    logic single_write;
+
+    // Bank state
+    logic bank_open [0:3];
+    logic [12:0] bank_row [0:3];
+    longint bank_act_at [0:3];
+    longint bank_pre_at [0:3];
+
+    // Running burst
+    logic burst_read;
+    logic burst_write;
+    logic [1:0] burst_bank;
+    logic [9:0] burst_col;
+    int burst_left;
+    int burst_index;
+    logic burst_precharge;
+
+    // Read data on its way out, one stage per clock
+    logic [15:0] rd_data [0:MAX_CL-1];
+    logic rd_valid [0:MAX_CL-1];
+    logic [15:0] dq_out;
+    logic dq_oe;
+
+    longint now;
+    longint last_refresh;
+    longint busy_until;                              // End of tRC/tMRD after a refresh or mode set
+
+    assign dq = dq_oe ? dq_out : 16'hzzzz;
+
+    function automatic int unsigned word_addr(input logic [1:0] b, input logic [12:0] r,
+                                              input logic [9:0] c);
+        return {b, r, c};
+    endfunction
+
+    // Column of the next word in a sequential burst (wraps within the burst)
+    function automatic logic [9:0] burst_next(input logic [9:0] c);
+        logic [9:0] mask;
+        mask = 10'(burst_len - 1);
+        return (c & ~mask) | ((c + 1) & mask);
+    endfunction
+
+    // Protocol errors so far, for a testbench to check
+    int errors = 0;
+
+    task automatic protocol_error(input string msg);
+        errors++;
+        $error("sdram_model: %s", msg);
+    endtask
+
+    task automatic end_burst();
+        if (burst_precharge) begin
+            bank_open[burst_bank] = 1'b0;
+            bank_pre_at[burst_bank] = now;
+        end
+        burst_read = 1'b0;
+        burst_write = 1'b0;
+    endtask
+
+    initial begin
+        mode_set = 1'b0;
+        cas_latency = 2;
+        burst_len = 1;
+        single_write = 1'b0;
+        burst_read = 1'b0;
+        burst_write = 1'b0;
+        burst_precharge = 1'b0;
+        burst_left = 0;
+        burst_index = 0;
+        dq_oe = 1'b0;
+        dq_out = 16'h0000;
+        now = 0;
+        last_refresh = 0;
+        busy_until = 0;
+        for (int b = 0; b < 4; b++) begin
+            bank_open[b] = 1'b0;
+            bank_row[b] = 0;
+            bank_act_at[b] = -1000;
+            bank_pre_at[b] = -1000;
+        end
+        for (int i = 0; i < MAX_CL; i++)
+            rd_valid[i] = 1'b0;
+    end
+
+    always @(posedge clk) begin
+        logic [3:0] cmd;
+        logic [15:0] word;
+        int unsigned a;
+
+        now++;
+        cmd = {cs_n, ras_n, cas_n, we_n};
+
+        // Read pipeline: the word entering stage 0 leaves CAS latency clocks later
+        dq_oe <= rd_valid[cas_latency - 1];
+        dq_out <= rd_data[cas_latency - 1];
+        for (int i = MAX_CL - 1; i > 0; i--) begin
+            rd_valid[i] = rd_valid[i - 1];
+            rd_data[i] = rd_data[i - 1];
+        end
+        rd_valid[0] = 1'b0;
+
+        if (cke && !cs_n) begin
+            if (cmd != 4'b0111) begin
+                if (now < T_INIT)
+                    protocol_error($sformatf("command %b before the 200 us power-up wait", cmd));
+                if (now < busy_until)
+                    protocol_error($sformatf("command %b inside tRC/tMRD", cmd));
+            end
+
+            case (cmd)
+                4'b0011: begin                       // ACTIVE
+                    if (!mode_set)
+                        protocol_error("ACTIVE before the mode register is set");
+                    if (bank_open[ba])
+                        protocol_error($sformatf("ACTIVE on open bank %0d", ba));
+                    if (now - bank_pre_at[ba] < T_RP)
+                        protocol_error($sformatf("tRP violated on bank %0d", ba));
+                    if (now - bank_act_at[ba] < T_RC)
+                        protocol_error($sformatf("tRC violated on bank %0d", ba));
+                    bank_open[ba] = 1'b1;
+                    bank_row[ba] = addr;
+                    bank_act_at[ba] = now;
+                end
+
+                4'b0101, 4'b0100: begin              // READ, WRITE
+                    if (!bank_open[ba])
+                        protocol_error($sformatf("%s to closed bank %0d",
+                                                 cmd == 4'b0101 ? "READ" : "WRITE", ba));
+                    if (now - bank_act_at[ba] < T_RCD)
+                        protocol_error($sformatf("tRCD violated on bank %0d", ba));
+                    // A new access cuts the running burst short
+                    if (burst_read || burst_write)
+                        end_burst();
+                    burst_bank = ba;
+                    burst_col = addr[9:0];
+                    burst_precharge = addr[10];
+                    burst_index = 0;
+                    burst_read = cmd == 4'b0101;
+                    burst_write = cmd == 4'b0100;
+                    burst_left = (burst_write && single_write) ? 1 : burst_len;
+                end
+
+                4'b0010: begin                       // PRECHARGE
+                    for (int b = 0; b < 4; b++) begin
+                        if ((addr[10] || b == ba) && bank_open[b]) begin
+                            bank_open[b] = 1'b0;
+                            bank_pre_at[b] = now;
+                        end
+                    end
+                    burst_read = 1'b0;
+                    burst_write = 1'b0;
+                end
+
+                4'b0001: begin                       // AUTO REFRESH
+                    for (int b = 0; b < 4; b++)
+                        if (bank_open[b])
+                            protocol_error($sformatf("REFRESH with bank %0d open", b));
+                    if (mode_set && now - last_refresh > 8 * T_REFI)
+                        protocol_error($sformatf("%0d cycles without a refresh", now - last_refresh));
+                    last_refresh = now;
+                    busy_until = now + T_RC;
+                end
+
+                4'b0000: begin                       // LOAD MODE REGISTER
+                    for (int b = 0; b < 4; b++)
+                        if (bank_open[b])
+                            protocol_error($sformatf("LOAD MODE with bank %0d open", b));
+                    cas_latency = addr[6:4];
+                    burst_len = 1 << addr[2:0];
+                    single_write = addr[9];
+                    if (addr[3] || !(cas_latency inside {2, 3}) || addr[2:0] > 3)
+                        protocol_error($sformatf("unsupported mode %h", addr));
+                    mode_set = 1'b1;
+                    last_refresh = now;
+                    busy_until = now + T_MRD;
+                end
+
+                default: ;                           // NOP, BURST TERMINATE
+            endcase
+        end
+
+        // Data phase of the running burst
+        if (burst_read || burst_write) begin
+            a = word_addr(burst_bank, bank_row[burst_bank], burst_col);
+            if (burst_read) begin
+                rd_data[0] = mem.exists(a) ? mem[a] : 16'hxxxx;
+                rd_valid[0] = 1'b1;
+            end else begin
+                word = mem.exists(a) ? mem[a] : 16'hxxxx;
+                if (!dqm[0])
+                    word[7:0] = dq[7:0];
+                if (!dqm[1])
+                    word[15:8] = dq[15:8];
+                if (dqm != 2'b11)
+                    mem[a] = word;
+            end
+            burst_col = burst_next(burst_col);
+            burst_index++;
+            burst_left--;
+            if (burst_left == 0)
+                end_burst();
+        end
+    end
+
+endmodule
@@ -0,0 +1,130 @@
+/**
+ * model_fuzz.cpp - Random fuzzing of the snake game rules on the C++ model
+ *
+ * Plays random games on snake::Model and checks the invariants the RTL
+ * relies on after every tick:
+ *   - the occupancy bitmap holds exactly `length` cells
+ *   - the body ring buffer and the bitmap agree, head and tail included
+ *   - the apple is never under the snake while a free cell is left
+ *   - game_speed stays within [GAME_SPEED_MIN, GAME_SPEED_MAX]
+ * and reports game steps per second.
+ *
+ * Usage: model_fuzz [--steps N] [--seed S] [--height H]
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include "snake_model.h"
+
+using snake::Model;
+
+static bool fail(uint64_t step, const char* what) {
+    std::fprintf(stderr, "step %llu: %s\n", static_cast<unsigned long long>(step), what);
+    return false;
+}
+
+// Full consistency check; slow, so only run every few ticks
+static bool check(const Model& m, const snake::Config& cfg, uint64_t step) {
+    unsigned cells = 0;
+    for (int y = 0; y < cfg.grid_height; y++)
+        for (int x = 0; x < cfg.grid_width; x++)
+            cells += m.occupied(x, y);
+    if (m.state() == snake::RUNNING && cells != m.length())
+        return fail(step, "occupancy count differs from snake length");
+    if (!m.occupied(m.head_x(), m.head_y()) || !m.occupied(m.tail_x(), m.tail_y()))
+        return fail(step, "head or tail cell not marked occupied");
+    if (m.game_speed() < static_cast<unsigned>(cfg.speed_min) ||
+        m.game_speed() > static_cast<unsigned>(cfg.speed_max))
+        return fail(step, "game_speed out of range");
+
+    unsigned inside = (cfg.grid_width - 2 * cfg.border_size) *
+                      (cfg.grid_height - 2 * cfg.border_size);
+    if (m.state() == snake::RUNNING && m.occupied(m.apple_x(), m.apple_y()) &&
+        !(m.apple_x() == m.head_x() && m.apple_y() == m.head_y()) && cells < inside)
+        return fail(step, "apple under the snake body with free cells left");
+    return true;
+}
+
+int main(int argc, char** argv) {
+    uint64_t steps = 10000000;
+    uint64_t seed = 1;
+    snake::Config cfg;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--steps" && i + 1 < argc) {
+            steps = std::strtoull(argv[++i], nullptr, 0);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 0);
+        } else if (arg == "--height" && i + 1 < argc) {
+            cfg.grid_height = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--steps N] [--seed S] [--height H]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::mt19937_64 rng(seed);
+    Model m(cfg);
+    bool border = true;
+    uint64_t games = 1;
+    uint64_t apples = 0;
+    unsigned best = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint64_t step = 0; step < steps; step++) {
+        uint64_t r = rng();
+
+        // Mostly keep going, sometimes turn; reversals are left in on
+        // purpose to exercise self collision
+        snake::Dir dir = m.direction();
+        if ((r & 63) == 0)
+            dir = static_cast<snake::Dir>((r >> 6) & 3);
+
+        // Steer towards the apple most of the time so games get long
+        else if ((r & 0x300) && m.state() == snake::RUNNING) {
+            int dx = m.apple_x() - m.head_x();
+            int dy = m.apple_y() - m.head_y();
+            snake::Dir want = dx > 0 ? snake::DIR_RIGHT : dx < 0 ? snake::DIR_LEFT
+                            : dy > 0 ? snake::DIR_DOWN : snake::DIR_UP;
+            int nx = m.head_x() + (want == snake::DIR_RIGHT) - (want == snake::DIR_LEFT);
+            int ny = m.head_y() + (want == snake::DIR_DOWN) - (want == snake::DIR_UP);
+            if (nx >= 0 && nx < cfg.grid_width && ny >= 0 && ny < cfg.grid_height &&
+                !m.occupied(nx, ny))
+                dir = want;
+        }
+        if ((r >> 16) % 100000 == 0)
+            border = !border;
+
+        unsigned score = m.score();
+        bool was_over = m.state() == snake::GAME_OVER;
+        m.tick(dir, border);
+
+        if (was_over)
+            games++;
+        else if (m.score() > score)
+            apples++;
+        if (m.score() > best)
+            best = m.score();
+
+        if ((step & 0xFF) == 0 && !check(m, cfg, step))
+            return 1;
+    }
+
+    auto stop = std::chrono::steady_clock::now();
+    double secs = std::chrono::duration<double>(stop - start).count();
+
+    std::printf("%llu steps, %llu games, %llu apples, best score %u in %.3f s: "
+                "%.2f Msteps/s\n",
+                static_cast<unsigned long long>(steps),
+                static_cast<unsigned long long>(games),
+                static_cast<unsigned long long>(apples), best, secs,
+                secs > 0 ? steps / secs / 1e6 : 0.0);
+    return 0;
+}
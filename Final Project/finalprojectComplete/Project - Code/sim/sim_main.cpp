@@ -0,0 +1,350 @@
+/**
+ * sim_main.cpp - Headless Verilator driver for DE10_Lite_Snake
+ *
+ * Clocks the board's 50 MHz input, grabs every frame from the VGA outputs
+ * and reports how many frames per wall-clock second the model runs at.
+ *
+ * Frames are decoded from VGA_R/G/B sampled on each pixel clock edge.
+ * The renderer's de_out flag marks the visible pixels, a falling edge of
+ * it ends a line and the active edge of VGA_VS ends a frame, so the grabber
+ * follows whatever resolution the model was built for.
+ *
+ * Usage: Vsnake [options]
+ *   --frames N        stop after N frames (default 120)
+ *   --dump DIR        write each frame as DIR/frame_NNNNN.ppm
+ *   --dump-every K    only dump every K-th frame (default 1)
+ *   --key F:K[:H]     press KEY[K] at frame F, held for H frames (default 3)
+ *   --sw HEX          switch settings after reset (default 0x001)
+ *   --record FILE     save the per-frame KEY/SW inputs as a trace
+ *   --replay FILE     take the inputs from a trace instead of --key/--sw
+ *                     (runs the whole trace unless --frames is given)
+ *   --cosim           check the game against the C++ model at every
+ *                     game_tick and stop at the first difference
+ *   --quiet           no per-frame lines, just the summary
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "verilated.h"
+#include "Vsnake.h"
+#include "Vsnake___024root.h"
+#include "snake_model.h"
+#include "snake_trace.h"
+
+#ifndef VIDEO_MODE
+#define VIDEO_MODE 0
+#endif
+#ifndef LFSR_SEED
+#define LFSR_SEED 0xACE1
+#endif
+#ifndef SIM_SPEEDUP
+#define SIM_SPEEDUP 1
+#endif
+
+// Vertical sync polarity and grid height of each mode in snake_pkg::video_mode()
+static const bool VS_ACTIVE_HIGH[] = {false, true, false, true};
+static const int GRID_HEIGHT[] = {24, 24, 24, 18};
+
+// snake_game signals made readable by snake.vlt
+#define RTL(sig) root->DE10_Lite_Snake__DOT__grid_mode__DOT__snake_inst__DOT__##sig
+
+// Cycles SW[0] (the game's reset) is held low at start-up
+static const int RESET_CYCLES = 100;
+
+struct KeyPress {
+    uint64_t frame;     // First frame the key is held down
+    int key;            // KEY index (0 or 1)
+    uint64_t hold;      // Frames the key stays down
+};
+
+struct Frame {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> rgb;   // 8-bit RGB, row-major
+
+    void clear() {
+        width = 0;
+        height = 0;
+        rgb.clear();
+    }
+};
+
+static void usage(const char* prog) {
+    std::fprintf(stderr,
+                 "usage: %s [--frames N] [--dump DIR] [--dump-every K] "
+                 "[--key F:K[:H]]... [--sw HEX] [--record FILE] [--replay FILE] "
+                 "[--cosim] [--quiet]\n",
+                 prog);
+    std::exit(2);
+}
+
+// Compare the RTL with the model just before a game_tick, when both hold
+// the result of the previous move and its apple placement
+static bool cosim_compare(const snake::Model& m, Vsnake___024root* root, uint64_t tick) {
+    struct Field {
+        const char* name;
+        unsigned rtl;
+        unsigned model;
+    };
+    const Field fields[] = {
+        {"game_state", RTL(game_state), m.state()},
+        {"head_x", RTL(head_x), static_cast<unsigned>(m.head_x())},
+        {"head_y", RTL(head_y), static_cast<unsigned>(m.head_y())},
+        {"apple_x", RTL(apple_x), static_cast<unsigned>(m.apple_x())},
+        {"apple_y", RTL(apple_y), static_cast<unsigned>(m.apple_y())},
+        {"snake_length", RTL(snake_length), m.length()},
+        {"score", RTL(score), m.score()},
+        {"game_speed", RTL(game_speed), m.game_speed()},
+        {"lfsr", RTL(lfsr), m.lfsr()},
+    };
+    for (const Field& f : fields) {
+        if (f.rtl != f.model) {
+            std::fprintf(stderr, "co-sim: first divergence before tick %llu: %s rtl=%u model=%u\n",
+                         static_cast<unsigned long long>(tick), f.name, f.rtl, f.model);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool write_ppm(const std::string& path, const Frame& f) {
+    FILE* fp = std::fopen(path.c_str(), "wb");
+    if (!fp) {
+        std::perror(path.c_str());
+        return false;
+    }
+    std::fprintf(fp, "P6\n%d %d\n255\n", f.width, f.height);
+    std::fwrite(f.rgb.data(), 1, f.rgb.size(), fp);
+    std::fclose(fp);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    uint64_t max_frames = 120;
+    bool frames_given = false;
+    std::string dump_dir;
+    uint64_t dump_every = 1;
+    std::vector<KeyPress> keys;
+    unsigned sw = 0x001;
+    bool quiet = false;
+    bool cosim = false;
+    std::string record_path;
+    std::string replay_path;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--frames" && has_value) {
+            max_frames = std::strtoull(argv[++i], nullptr, 0);
+            frames_given = true;
+        } else if (arg == "--dump" && has_value) {
+            dump_dir = argv[++i];
+        } else if (arg == "--dump-every" && has_value) {
+            dump_every = std::strtoull(argv[++i], nullptr, 0);
+            if (dump_every == 0)
+                dump_every = 1;
+        } else if (arg == "--key" && has_value) {
+            KeyPress kp = {0, 0, 3};
+            unsigned long long frame, hold = 3;
+            int key;
+            int n = std::sscanf(argv[++i], "%llu:%d:%llu", &frame, &key, &hold);
+            if (n < 2 || key < 0 || key > 1)
+                usage(argv[0]);
+            kp.frame = frame;
+            kp.key = key;
+            kp.hold = hold;
+            keys.push_back(kp);
+        } else if (arg == "--sw" && has_value) {
+            sw = std::strtoul(argv[++i], nullptr, 16) & 0x3FF;
+        } else if (arg == "--record" && has_value) {
+            record_path = argv[++i];
+        } else if (arg == "--replay" && has_value) {
+            replay_path = argv[++i];
+        } else if (arg == "--cosim") {
+            cosim = true;
+        } else if (arg == "--quiet") {
+            quiet = true;
+        } else if (arg.rfind("+verilator", 0) == 0) {
+            // Verilator runtime options, handled by commandArgs
+        } else {
+            usage(argv[0]);
+        }
+    }
+
+    // Input traces
+    snake::TraceReader replay;
+    snake::TraceWriter record;
+    if (!replay_path.empty()) {
+        if (!replay.open(replay_path)) {
+            std::fprintf(stderr, "%s: %s\n", replay_path.c_str(), replay.error().c_str());
+            return 1;
+        }
+        if (replay.lfsr_seed() != LFSR_SEED) {
+            std::fprintf(stderr, "%s: recorded with LFSR_SEED=0x%04X, model built with 0x%04X "
+                         "(rebuild with make LFSR_SEED=0x%04X)\n", replay_path.c_str(),
+                         replay.lfsr_seed(), LFSR_SEED, replay.lfsr_seed());
+            return 1;
+        }
+        if (!frames_given || max_frames > replay.frames())
+            max_frames = replay.frames();
+    }
+    if (!record_path.empty() && !record.open(record_path, LFSR_SEED, 0)) {
+        std::perror(record_path.c_str());
+        return 1;
+    }
+
+    auto contextp = std::make_unique<VerilatedContext>();
+    contextp->commandArgs(argc, argv);
+    auto top = std::make_unique<Vsnake>(contextp.get());
+    Vsnake___024root* root = top->rootp;
+
+    const bool vs_active = VS_ACTIVE_HIGH[VIDEO_MODE];
+
+    snake::Config model_cfg;
+    model_cfg.grid_height = GRID_HEIGHT[VIDEO_MODE];
+    model_cfg.lfsr_seed = LFSR_SEED;
+    // Frames per move as DE10_Lite_Snake plays them (snake_game's SPEED_MAX/MIN)
+    model_cfg.speed_max = std::max(model_cfg.speed_max / SIM_SPEEDUP, 1);
+    model_cfg.speed_min = std::max(model_cfg.speed_min / SIM_SPEEDUP, 1);
+    snake::Model model(model_cfg);
+
+    top->MAX10_CLK1_50 = 0;
+    top->MAX10_CLK2_50 = 0;
+    top->ADC_CLK_10 = 0;
+    top->KEY = 0x3;                     // Active low: nothing pressed
+    top->SW = 0;                        // SW[0] low holds the game in reset
+
+    Frame frame;
+    int col = 0;
+    bool prev_pclk = false;
+    bool prev_de = false;
+    bool prev_vs = !vs_active;
+    uint64_t frames = 0;
+    uint64_t cycles = 0;
+    snake::FrameInput input;
+    uint64_t input_frame = UINT64_MAX;
+
+    auto start = std::chrono::steady_clock::now();
+
+    while (frames < max_frames && !contextp->gotFinish()) {
+        // Inputs change once per frame (KEY is active low on the board)
+        if (frames != input_frame) {
+            input_frame = frames;
+            if (!replay_path.empty()) {
+                if (!replay.next(input)) {
+                    if (!replay.error().empty())
+                        std::fprintf(stderr, "%s: %s\n", replay_path.c_str(),
+                                     replay.error().c_str());
+                    break;
+                }
+            } else {
+                input.key = 0x3;
+                for (const KeyPress& kp : keys)
+                    if (frames >= kp.frame && frames < kp.frame + kp.hold)
+                        input.key &= ~(1u << kp.key);
+                input.sw = static_cast<uint16_t>(sw);
+            }
+            if (!record_path.empty())
+                record.frame(input);
+        }
+        top->KEY = input.key;
+        top->SW = (cycles < RESET_CYCLES) ? 0 : input.sw;
+
+        // The move taken on this clock edge, checked and replayed on the model
+        if (cosim && cycles >= RESET_CYCLES && RTL(game_tick)) {
+            if (!cosim_compare(model, root, model.ticks()))
+                return 1;
+            model.tick(static_cast<snake::Dir>(RTL(move_dir)), RTL(border_visible));
+        }
+
+        // One 50 MHz cycle
+        top->MAX10_CLK1_50 = 1;
+        top->eval();
+        contextp->timeInc(10);
+        top->MAX10_CLK1_50 = 0;
+        top->eval();
+        contextp->timeInc(10);
+        cycles++;
+
+        // The VGA outputs only change on a pixel clock rising edge
+        bool pclk = root->DE10_Lite_Snake__DOT__grid_mode__DOT__snake_inst__DOT__pixel_clk;
+        if (!pclk || prev_pclk) {
+            prev_pclk = pclk;
+            continue;
+        }
+        prev_pclk = pclk;
+
+        bool de = root->DE10_Lite_Snake__DOT__grid_mode__DOT__snake_inst__DOT__display_inst__DOT__render_inst__DOT__de_out;
+        bool vs = top->VGA_VS;
+
+        if (de) {
+            if (!prev_de) {
+                // First pixel of a new line
+                frame.height++;
+                col = 0;
+            }
+            if (frame.height == 1)
+                frame.width = col + 1;
+            if (col < frame.width) {
+                frame.rgb.push_back(static_cast<uint8_t>(top->VGA_R * 17));
+                frame.rgb.push_back(static_cast<uint8_t>(top->VGA_G * 17));
+                frame.rgb.push_back(static_cast<uint8_t>(top->VGA_B * 17));
+            }
+            col++;
+        }
+        prev_de = de;
+
+        // Active edge of vertical sync: the frame above is complete
+        if (vs == vs_active && prev_vs != vs_active) {
+            if (frame.height > 0) {
+                if (!quiet)
+                    std::printf("frame %llu: %dx%d, cycle %llu\n",
+                                static_cast<unsigned long long>(frames),
+                                frame.width, frame.height,
+                                static_cast<unsigned long long>(cycles));
+                if (!dump_dir.empty() && frames % dump_every == 0) {
+                    char name[32];
+                    std::snprintf(name, sizeof(name), "/frame_%05llu.ppm",
+                                  static_cast<unsigned long long>(frames));
+                    if (!write_ppm(dump_dir + name, frame))
+                        return 1;
+                }
+            }
+            frames++;
+            frame.clear();
+            col = 0;
+        }
+        prev_vs = vs;
+    }
+
+    auto stop = std::chrono::steady_clock::now();
+    double secs = std::chrono::duration<double>(stop - start).count();
+
+    top->final();
+
+    if (!record_path.empty() && !record.close()) {
+        std::perror(record_path.c_str());
+        return 1;
+    }
+
+    if (cosim)
+        std::printf("co-sim: %llu ticks matched the model\n",
+                    static_cast<unsigned long long>(model.ticks()));
+
+    std::printf("%llu frames, %llu cycles in %.3f s: %.2f frames/s, %.2f Mcycles/s "
+                "(%d thread%s)\n",
+                static_cast<unsigned long long>(frames),
+                static_cast<unsigned long long>(cycles), secs,
+                secs > 0 ? frames / secs : 0.0,
+                secs > 0 ? cycles / secs / 1e6 : 0.0,
+                contextp->threads(), contextp->threads() == 1 ? "" : "s");
+    return 0;
+}
@@ -0,0 +1,173 @@
+/**
+ * snake_model.cpp - Bit-accurate C++ reference model of snake_game.sv
+ *
+ * Each block below names the piece of RTL it mirrors.
+ */
+
+#include "snake_model.h"
+
+namespace snake {
+
+static int clog2(unsigned v) {
+    int bits = 0;
+    while ((1u << bits) < v)
+        bits++;
+    return bits;
+}
+
+static int popcount32(uint32_t v) {
+    return __builtin_popcount(v);
+}
+
+Model::Model(const Config& cfg) : cfg_(cfg) {
+    x_bits_ = clog2(cfg_.grid_width);
+    num_cells_ = static_cast<unsigned>(cfg_.grid_width * cfg_.grid_height);
+    body_.assign(1u << clog2(num_cells_), 0);   // body_ram depth
+    occupied_.assign(cfg_.grid_height, 0);
+
+    // apple_placer COL_MASK
+    uint32_t row_mask = (cfg_.grid_width >= 32) ? 0xFFFFFFFFu : ((1u << cfg_.grid_width) - 1);
+    col_mask_ = ((row_mask << cfg_.border_size) & row_mask) & (row_mask >> cfg_.border_size);
+
+    reset();
+}
+
+// LFSR implementation for pseudo-random numbers
+uint16_t Model::lfsr_step(uint16_t v) {
+    unsigned fb = ((v >> 15) ^ (v >> 13) ^ (v >> 12) ^ (v >> 10)) & 1u;
+    return static_cast<uint16_t>((v << 1) | fb);
+}
+
+void Model::reset() {
+    state_ = RUNNING;
+    length_ = cfg_.init_snake_len;
+    speed_ = cfg_.speed_max;
+    score_ = 0;
+    apple_x_ = cfg_.grid_width / 4;
+    apple_y_ = cfg_.grid_height / 4;
+    lfsr_ = cfg_.lfsr_seed;
+    dir_ = DIR_RIGHT;
+    ticks_ = 0;
+    hit_border_ = false;
+    hit_self_ = false;
+    lay_out_snake();
+}
+
+// IDLE: lay out the initial snake, tail first, ending at the center
+void Model::lay_out_snake() {
+    for (auto& row : occupied_)
+        row = 0;
+    int y = cfg_.grid_height / 2;
+    for (int i = 0; i < cfg_.init_snake_len; i++) {
+        int x = cfg_.grid_width / 2 - cfg_.init_snake_len + 1 + i;
+        body_[i] = cell(x, y);
+        occupied_[y] |= 1u << x;
+    }
+    head_x_ = cfg_.grid_width / 2;
+    head_y_ = y;
+    head_ptr_ = cfg_.init_snake_len - 1;
+    tail_ptr_ = 0;
+    state_ = RUNNING;
+}
+
+// apple_placer: the rank-th free cell inside the border, in {y, x} order,
+// with rank = (rand * free_cells) >> 16. The apple stays put if the board
+// is full.
+void Model::place_apple() {
+    uint32_t free_rows[32];
+    unsigned total = 0;
+    for (int y = 0; y < cfg_.grid_height; y++) {
+        bool inside = y >= cfg_.border_size && y < cfg_.grid_height - cfg_.border_size;
+        free_rows[y] = inside ? (~occupied_[y] & col_mask_) : 0;
+        total += popcount32(free_rows[y]);
+    }
+    if (total == 0)
+        return;
+
+    unsigned rank = static_cast<unsigned>((static_cast<uint32_t>(lfsr_) * total) >> 16);
+    for (int y = 0; y < cfg_.grid_height; y++) {
+        unsigned n = popcount32(free_rows[y]);
+        if (rank < n) {
+            uint32_t bits = free_rows[y];
+            for (unsigned i = 0; i < rank; i++)
+                bits &= bits - 1;               // Drop the lowest free cell
+            apple_x_ = __builtin_ctz(bits);
+            apple_y_ = y;
+            return;
+        }
+        rank -= n;
+    }
+}
+
+void Model::tick(Dir dir, bool border_visible) {
+    ticks_++;
+    lfsr_ = lfsr_step(lfsr_);
+    hit_border_ = false;
+    hit_self_ = false;
+
+    if (state_ == GAME_OVER) {
+        // Reset the game; the apple and direction carry over
+        length_ = cfg_.init_snake_len;
+        speed_ = cfg_.speed_max;
+        score_ = 0;
+        lay_out_snake();
+        return;
+    }
+
+    const int w = cfg_.grid_width;
+    const int h = cfg_.grid_height;
+    const int b = cfg_.border_size;
+
+    // Next head position (wraps within the grid)
+    int next_x = head_x_;
+    int next_y = head_y_;
+    switch (dir) {
+    case DIR_RIGHT: next_x = (head_x_ == w - 1) ? 0 : head_x_ + 1; break;
+    case DIR_LEFT:  next_x = (head_x_ == 0) ? w - 1 : head_x_ - 1; break;
+    case DIR_DOWN:  next_y = (head_y_ == h - 1) ? 0 : head_y_ + 1; break;
+    case DIR_UP:    next_y = (head_y_ == 0) ? h - 1 : head_y_ - 1; break;
+    }
+
+    bool hit_border = border_visible &&
+        ((head_x_ == b - 1 && dir == DIR_LEFT) ||
+         (head_x_ == w - b && dir == DIR_RIGHT) ||
+         (head_y_ == b - 1 && dir == DIR_UP) ||
+         (head_y_ == h - b && dir == DIR_DOWN));
+
+    bool grows = next_x == apple_x_ && next_y == apple_y_;
+    bool hit_self = occupied(next_x, next_y) &&
+                    !(next_x == tail_x() && next_y == tail_y() && !grows);
+
+    dir_ = dir;
+
+    if (hit_border || hit_self) {
+        hit_border_ = hit_border;
+        hit_self_ = !hit_border && hit_self;
+        state_ = GAME_OVER;
+        return;
+    }
+
+    // Advance the head; retire the tail unless growing (tail bit cleared
+    // before the head bit is set)
+    const unsigned ring_mask = static_cast<unsigned>(body_.size() - 1);
+    if (!grows) {
+        occupied_[tail_y()] &= ~(1u << tail_x());
+        tail_ptr_ = (tail_ptr_ + 1) & ring_mask;
+    }
+    head_ptr_ = (head_ptr_ + 1) & ring_mask;
+    body_[head_ptr_] = cell(next_x, next_y);
+    occupied_[next_y] |= 1u << next_x;
+    head_x_ = next_x;
+    head_y_ = next_y;
+
+    if (grows) {
+        if (length_ < num_cells_)
+            length_++;
+        score_++;
+        if (speed_ >= static_cast<unsigned>(cfg_.speed_min + cfg_.speed_decrement))
+            speed_ -= cfg_.speed_decrement;
+        place_apple();
+    }
+}
+
+} // namespace snake
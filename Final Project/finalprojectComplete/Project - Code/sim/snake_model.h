@@ -0,0 +1,101 @@
+/**
+ * snake_model.h - Bit-accurate C++ reference model of snake_game.sv
+ *
+ * The model advances one game_tick at a time and follows the RTL's rules
+ * exactly: the 16-bit LFSR (stepped once per game_tick), wrap-around
+ * movement, the border and self collision checks, growth and score, the
+ * game_speed schedule and the apple_placer's rank/select choice of the
+ * next apple. The state it exposes is the state the RTL holds just before
+ * each game_tick, which is where the co-simulation compares the two.
+ *
+ * It keeps no per-cycle or per-pixel state, so it runs millions of game
+ * steps per second for fuzzing the rules.
+ */
+
+#ifndef SNAKE_MODEL_H
+#define SNAKE_MODEL_H
+
+#include <cstdint>
+#include <vector>
+
+namespace snake {
+
+// Encodings match snake_pkg::direction_t and snake_game's game_state_t
+enum Dir : uint8_t { DIR_RIGHT = 0, DIR_DOWN = 1, DIR_LEFT = 2, DIR_UP = 3 };
+enum State : uint8_t { IDLE = 0, RUNNING = 1, GAME_OVER = 2 };
+
+// snake_game parameters (defaults are the RTL's)
+struct Config {
+    int grid_width = 32;
+    int grid_height = 24;       // 18 in the 1280x720 mode
+    int border_size = 1;
+    int init_snake_len = 1;
+    int speed_max = 14;         // GAME_SPEED_MAX, frames per move
+    int speed_min = 4;          // GAME_SPEED_MIN
+    int speed_decrement = 1;    // GAME_SPEED_DECREMENT
+    uint16_t lfsr_seed = 0xACE1;
+};
+
+class Model {
+public:
+    explicit Model(const Config& cfg = Config());
+
+    // State after reset (the RTL lays out the snake before the first tick)
+    void reset();
+
+    // One game_tick. dir is the direction of the move (the RTL's move_dir);
+    // border_visible is snake_game's registered SW[0].
+    void tick(Dir dir, bool border_visible);
+
+    State state() const { return state_; }
+    int head_x() const { return head_x_; }
+    int head_y() const { return head_y_; }
+    int apple_x() const { return apple_x_; }
+    int apple_y() const { return apple_y_; }
+    int tail_x() const { return cell_x(body_[tail_ptr_]); }
+    int tail_y() const { return cell_y(body_[tail_ptr_]); }
+    unsigned length() const { return length_; }
+    unsigned score() const { return score_; }
+    unsigned game_speed() const { return speed_; }
+    uint16_t lfsr() const { return lfsr_; }
+    Dir direction() const { return dir_; }
+    bool occupied(int x, int y) const { return (occupied_[y] >> x) & 1u; }
+    uint64_t ticks() const { return ticks_; }
+
+    // Last tick ended the game, and why
+    bool hit_border() const { return hit_border_; }
+    bool hit_self() const { return hit_self_; }
+
+    static uint16_t lfsr_step(uint16_t v);
+
+private:
+    uint16_t cell(int x, int y) const { return static_cast<uint16_t>((y << x_bits_) | x); }
+    int cell_x(uint16_t c) const { return c & ((1 << x_bits_) - 1); }
+    int cell_y(uint16_t c) const { return c >> x_bits_; }
+
+    void lay_out_snake();
+    void place_apple();
+
+    Config cfg_;
+    int x_bits_;
+    unsigned num_cells_;
+    uint32_t col_mask_;                 // Columns inside the border
+
+    State state_;
+    int head_x_, head_y_;
+    int apple_x_, apple_y_;
+    std::vector<uint16_t> body_;        // Ring buffer of {y, x}, like body_ram
+    unsigned head_ptr_, tail_ptr_;
+    std::vector<uint32_t> occupied_;    // One bit per cell, like occupied[]
+    unsigned length_;
+    unsigned score_;
+    unsigned speed_;
+    uint16_t lfsr_;
+    Dir dir_;
+    uint64_t ticks_;
+    bool hit_border_, hit_self_;
+};
+
+} // namespace snake
+
+#endif // SNAKE_MODEL_H
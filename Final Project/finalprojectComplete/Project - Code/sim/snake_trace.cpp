@@ -0,0 +1,183 @@
+/**
+ * snake_trace.cpp - Per-frame input trace for the snake game
+ *
+ * See snake_trace.h for the file layout.
+ */
+
+#include "snake_trace.h"
+
+#include <cstring>
+
+namespace snake {
+
+static const char MAGIC[4] = {'S', 'N', 'K', 'T'};
+static const long FRAMES_OFFSET = 8;
+
+static void put_u16(FILE* fp, uint16_t v) {
+    std::fputc(v & 0xFF, fp);
+    std::fputc(v >> 8, fp);
+}
+
+static void put_u32(FILE* fp, uint32_t v) {
+    put_u16(fp, v & 0xFFFF);
+    put_u16(fp, v >> 16);
+}
+
+static bool get_u8(FILE* fp, uint8_t& v) {
+    int c = std::fgetc(fp);
+    if (c == EOF)
+        return false;
+    v = static_cast<uint8_t>(c);
+    return true;
+}
+
+static bool get_u16(FILE* fp, uint16_t& v) {
+    uint8_t lo, hi;
+    if (!get_u8(fp, lo) || !get_u8(fp, hi))
+        return false;
+    v = static_cast<uint16_t>(lo | (hi << 8));
+    return true;
+}
+
+static bool get_u32(FILE* fp, uint32_t& v) {
+    uint16_t lo, hi;
+    if (!get_u16(fp, lo) || !get_u16(fp, hi))
+        return false;
+    v = lo | (static_cast<uint32_t>(hi) << 16);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Writer
+//-----------------------------------------------------------------------------
+
+TraceWriter::~TraceWriter() {
+    close();
+}
+
+bool TraceWriter::open(const std::string& path, uint16_t lfsr_seed, uint16_t initial_sw) {
+    fp_ = std::fopen(path.c_str(), "wb");
+    if (!fp_)
+        return false;
+    std::fwrite(MAGIC, 1, sizeof(MAGIC), fp_);
+    std::fputc(TRACE_VERSION, fp_);
+    std::fputc(0, fp_);
+    put_u16(fp_, lfsr_seed);
+    put_u32(fp_, 0);                        // Frame count, patched by close()
+    put_u16(fp_, initial_sw);
+    sw_ = initial_sw;
+    run_len_ = 0;
+    frames_ = 0;
+    return true;
+}
+
+void TraceWriter::frame(const FrameInput& in) {
+    if (run_len_ != 0 && in != run_)
+        put_run();
+    run_ = in;
+    run_len_++;
+    frames_++;
+}
+
+void TraceWriter::put_run() {
+    uint64_t extra = (run_len_ - 1) >> 4;
+    uint8_t token = static_cast<uint8_t>(((run_.key & 0x3) << 6) | ((run_len_ - 1) & 0xF));
+    if (run_.sw != sw_)
+        token |= 0x20;
+    if (extra != 0)
+        token |= 0x10;
+
+    std::fputc(token, fp_);
+    if (run_.sw != sw_) {
+        put_u16(fp_, run_.sw);
+        sw_ = run_.sw;
+    }
+    while (extra != 0) {
+        uint8_t b = extra & 0x7F;
+        extra >>= 7;
+        std::fputc(extra ? (b | 0x80) : b, fp_);
+    }
+    run_len_ = 0;
+}
+
+bool TraceWriter::close() {
+    if (!fp_)
+        return true;
+    if (run_len_ != 0)
+        put_run();
+    std::fseek(fp_, FRAMES_OFFSET, SEEK_SET);
+    put_u32(fp_, frames_);
+    bool ok = std::ferror(fp_) == 0;
+    ok = std::fclose(fp_) == 0 && ok;
+    fp_ = nullptr;
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+// Reader
+//-----------------------------------------------------------------------------
+
+TraceReader::~TraceReader() {
+    if (fp_)
+        std::fclose(fp_);
+}
+
+bool TraceReader::fail(const char* what) {
+    error_ = what;
+    return false;
+}
+
+bool TraceReader::open(const std::string& path) {
+    fp_ = std::fopen(path.c_str(), "rb");
+    if (!fp_)
+        return fail("cannot open trace");
+
+    char magic[4];
+    uint8_t version, reserved;
+    if (std::fread(magic, 1, sizeof(magic), fp_) != sizeof(magic) ||
+        std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+        return fail("not a snake trace");
+    if (!get_u8(fp_, version) || !get_u8(fp_, reserved) ||
+        !get_u16(fp_, seed_) || !get_u32(fp_, frames_) || !get_u16(fp_, run_.sw))
+        return fail("truncated header");
+    if (version != TRACE_VERSION)
+        return fail("unsupported trace version");
+    run_left_ = 0;
+    read_ = 0;
+    return true;
+}
+
+bool TraceReader::next(FrameInput& in) {
+    if (read_ >= frames_)
+        return false;
+
+    if (run_left_ == 0) {
+        uint8_t token;
+        if (!get_u8(fp_, token))
+            return fail("trace ends early");
+        run_.key = token >> 6;
+        if (token & 0x20) {
+            if (!get_u16(fp_, run_.sw))
+                return fail("trace ends early");
+        }
+        uint64_t extra = 0;
+        if (token & 0x10) {
+            uint8_t b;
+            int shift = 0;
+            do {
+                if (!get_u8(fp_, b) || shift > 56)
+                    return fail("bad run length");
+                extra |= static_cast<uint64_t>(b & 0x7F) << shift;
+                shift += 7;
+            } while (b & 0x80);
+        }
+        run_left_ = (extra << 4) + (token & 0xF) + 1;
+    }
+
+    run_left_--;
+    read_++;
+    in = run_;
+    return true;
+}
+
+} // namespace snake
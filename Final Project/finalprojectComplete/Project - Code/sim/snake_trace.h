@@ -0,0 +1,91 @@
+/**
+ * snake_trace.h - Per-frame input trace for the snake game
+ *
+ * A trace records the board inputs (KEY and SW of DE10_Lite_Snake) once
+ * per video frame, together with the LFSR seed the design was built with.
+ * Frame f's inputs apply from the first clock after the f-th active edge of
+ * VGA_VS following reset (SW is held at 0 for the reset cycles first), so
+ * a replay reproduces a session exactly.
+ *
+ * File layout (little-endian):
+ *   header, 14 bytes
+ *     0  "SNKT"          magic
+ *     4  u8  version     TRACE_VERSION
+ *     5  u8  reserved    0
+ *     6  u16 lfsr_seed   snake_game LFSR_SEED of the recording
+ *     8  u32 frames      number of frames in the trace
+ *     12 u16 sw          SW before the first record
+ *   records, one per run of identical frames
+ *     token byte: [7:6] KEY  [5] SW follows  [4] length varint follows
+ *                 [3:0] (run length - 1) & 0xF
+ *     if [5]: u16 new SW (only sent when SW changes)
+ *     if [4]: LEB128 varint, (run length - 1) >> 4
+ *
+ * Idle stretches cost one or two bytes however long they are, so an hour of
+ * play (216k frames) is a few kilobytes: roughly four bytes per key press.
+ */
+
+#ifndef SNAKE_TRACE_H
+#define SNAKE_TRACE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace snake {
+
+static const uint8_t TRACE_VERSION = 1;
+
+// Board inputs for one frame (KEY is active low, as on the board)
+struct FrameInput {
+    uint8_t key = 0x3;
+    uint16_t sw = 0;
+
+    bool operator==(const FrameInput& o) const { return key == o.key && sw == o.sw; }
+    bool operator!=(const FrameInput& o) const { return !(*this == o); }
+};
+
+class TraceWriter {
+public:
+    ~TraceWriter();
+
+    bool open(const std::string& path, uint16_t lfsr_seed, uint16_t initial_sw);
+    void frame(const FrameInput& in);
+    bool close();                           // Flushes the last run and the frame count
+
+private:
+    void put_run();
+
+    FILE* fp_ = nullptr;
+    FrameInput run_;
+    uint64_t run_len_ = 0;
+    uint16_t sw_ = 0;                       // SW as of the last record written
+    uint32_t frames_ = 0;
+};
+
+class TraceReader {
+public:
+    ~TraceReader();
+
+    bool open(const std::string& path);
+    bool next(FrameInput& in);              // false at the end of the trace
+
+    uint16_t lfsr_seed() const { return seed_; }
+    uint32_t frames() const { return frames_; }
+    const std::string& error() const { return error_; }
+
+private:
+    bool fail(const char* what);
+
+    FILE* fp_ = nullptr;
+    FrameInput run_;
+    uint64_t run_left_ = 0;
+    uint16_t seed_ = 0;
+    uint32_t frames_ = 0;
+    uint32_t read_ = 0;
+    std::string error_;
+};
+
+} // namespace snake
+
+#endif // SNAKE_TRACE_H
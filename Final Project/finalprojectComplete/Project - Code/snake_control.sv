@@ -0,0 +1,163 @@
+// Move timing and steering shared by the game engines (snake_game,
+// snake_world).
+//
+// Game tick: a move falls due every speed frames, counted on the frame
+// tick, and is taken (game_tick) once the engine says it is ready. A tick
+// always takes the due move, even on a frame tick, and no tick is given on
+// the clock after one, so the engine has a cycle to show it is busy with
+// the move before ready is looked at again.
+//
+// Direction: key presses queue up turns (see turn_queue), one taken per
+// move, and the move uses the queued turn directly, so a press is never
+// held back by more than the moves queued ahead of it. A steer input (the
+// autopilot) overrides the queue. The latency of each queued turn, from
+// the key pulse to the move that takes it, is kept in latency_stats, and
+// the engine's events are counted in perf_counters.
+module snake_control
+    import snake_pkg::*;
+#(
+    parameter SPEED_BITS = 5,                        // Width of speed (frames per move)
+    parameter TURN_QUEUE_DEPTH = 4                   // Key presses held for upcoming moves
+)(
+    input  logic clk,
+    input  logic reset_n,
+
+    // Game tick
+    input  logic frame_tick,
+    input  logic [SPEED_BITS-1:0] speed,             // Frames per move
+    input  logic ready,                              // The engine can take a move
+    output logic game_tick,
+
+    // Direction
+    input  logic [1:0] KEY,                          // Key pulses, KEY[0] clockwise
+    input  logic turns_on,                           // Queue key presses (game running, no autopilot)
+    input  logic steer_valid,                        // Use steer_dir for the move
+    input  direction_t steer_dir,
+    input  logic take,                               // The engine takes the move this cycle
+    input  logic move_ok,                            // and it does not end the game
+    output direction_t move_dir,                     // Direction of the pending move
+    output direction_t curr_direction,               // Direction of the last move
+
+    // Turn latency, key pulse to head move, in clk cycles
+    output logic [31:0] turn_lat_min,
+    output logic [31:0] turn_lat_max,
+    output logic [31:0] turn_lat_avg,
+    output logic [7:0] turns_dropped,                // Turns lost to a full turn queue
+
+    // Performance counter events not seen here, and the Avalon-MM slave
+    input  logic move_commit,
+    input  logic apple,
+    input  logic [2:0] perf_address,
+    input  logic perf_read,
+    output logic [31:0] perf_readdata,
+    input  logic perf_write,
+    input  logic [31:0] perf_writedata
+);
+
+    logic [SPEED_BITS-1:0] move_counter;             // Frames since the last move
+    logic step_due;                                  // A move is due this frame
+    logic move_in_flight;                            // game_tick last cycle
+
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n) begin
+            move_counter <= 0;
+            step_due <= 0;
+            move_in_flight <= 0;
+        end else begin
+            move_in_flight <= game_tick;
+            if (game_tick)
+                step_due <= 0;
+            if (frame_tick) begin
+                if (move_counter >= speed - 1'b1) begin
+                    move_counter <= 0;
+                    step_due <= 1;
+                end else begin
+                    move_counter <= move_counter + 1'b1;
+                end
+            end
+        end
+    end
+
+    assign game_tick = step_due && ready && !move_in_flight;
+
+    logic [31:0] cycle_count;                        // Timestamp for queued turns
+    logic turn_empty, turn_pop, turn_drop;
+    direction_t turn_dir;
+    logic [31:0] turn_stamp;
+
+    turn_queue #(
+        .DEPTH(TURN_QUEUE_DEPTH),
+        .STAMP_BITS(32)
+    ) turn_inst (
+        .clk(clk),
+        .reset_n(reset_n),
+        .clear(!turns_on),
+        .rotate_cw(KEY[0]),
+        .rotate_ccw(KEY[1]),
+        .curr_direction(curr_direction),
+        .now(cycle_count),
+        .pop(turn_pop),
+        .empty(turn_empty),
+        .turn_dir(turn_dir),
+        .turn_stamp(turn_stamp),
+        .dropped(turns_dropped),
+        .drop(turn_drop)
+    );
+
+    always_comb begin
+        if (steer_valid)
+            move_dir = steer_dir;
+        else if (turns_on && !turn_empty)
+            move_dir = turn_dir;
+        else
+            move_dir = curr_direction;
+    end
+
+    assign turn_pop = take && turns_on;
+
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n) begin
+            curr_direction <= DIR_RIGHT;
+            cycle_count <= 0;
+        end else begin
+            cycle_count <= cycle_count + 1;
+            if (take)
+                curr_direction <= move_dir;
+        end
+    end
+
+    // Turn latency: from the key pulse to the move that takes the turn,
+    // for moves not known at the tick to end the game
+    latency_stats #(
+        .WIDTH(32)
+    ) turn_lat_inst (
+        .clk(clk),
+        .reset_n(reset_n),
+        .sample_valid(turn_pop && !turn_empty && move_ok),
+        .sample(cycle_count - turn_stamp),
+        .min(turn_lat_min),
+        .max(turn_lat_max),
+        .avg(turn_lat_avg),
+        .sum(),
+        .count()
+    );
+
+    // One collision check per move taken; a move starts unless the check
+    // ends the game
+    perf_counters perf_inst (
+        .clk(clk),
+        .reset_n(reset_n),
+        .frame(frame_tick),
+        .move_start(take && move_ok),
+        .move_commit(move_commit),
+        .apple(apple),
+        .collision_check(take),
+        .turn_drop(turn_drop),
+        .avs_address(perf_address),
+        .avs_read(perf_read),
+        .avs_readdata(perf_readdata),
+        .avs_write(perf_write),
+        .avs_writedata(perf_writedata)
+    );
+
+endmodule
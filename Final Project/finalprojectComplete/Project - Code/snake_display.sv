@@ -0,0 +1,201 @@
+// Video side shared by the game engines (snake_game, snake_world): the
+// pixel clock PLL and pixel-domain reset, VGA timing, the frame tick, the
+// status text and the pixel pipeline.
+//
+// The engine answers the renderer's tile map reads (cell code one
+// pixel_clk after the address) and supplies the values for the status
+// line. Everything else about the picture is set here.
+module snake_display
+    import snake_pkg::*;
+#(
+    parameter video_mode_sel_t VIDEO_MODE = VIDEO_640X480, // Video mode, see snake_pkg
+    parameter GRID_WIDTH = 32,                       // Cells on screen, H_PIXELS / cell size
+    parameter GRID_HEIGHT = 24,                      // and V_PIXELS / cell size
+    parameter GAME_SPEED_MAX = 14,                   // Slowest game speed, for the status line
+
+    // Color definitions (4-bit RGB)
+    parameter [11:0] COLOR_BLACK = 12'h000,          // Background
+    parameter [11:0] COLOR_GREEN = 12'h0F0,          // Snake
+    parameter [11:0] COLOR_RED = 12'hF00,            // Apple
+    parameter [11:0] COLOR_BLUE = 12'h00F,           // Border
+    parameter [11:0] COLOR_DARK_GREEN = 12'h080,     // Snake body
+    parameter [11:0] COLOR_DARK_BLUE = 12'h008,      // Border mortar
+    parameter [11:0] COLOR_DARK_RED = 12'h800,       // Apple shade
+    parameter [11:0] COLOR_WHITE = 12'hFFF,          // Snake eyes
+    parameter [11:0] COLOR_TEXT = 12'hFF0            // Score and status text
+)(
+    input  logic clk,                                // 50MHz system clock
+    input  logic reset_n,                            // Active low reset
+
+    output logic pixel_clk,
+    output logic pixel_reset_n,                      // reset_n released on pixel_clk
+    output logic v_sync,                             // Vertical sync from the VGA controller (pixel_clk)
+    output logic frame_tick,                         // Start of vertical sync, one clk pulse per frame
+
+    // Tile map read port of the renderer ({y, x} address, data one
+    // pixel_clk later)
+    output logic [$clog2(GRID_WIDTH)+$clog2(GRID_HEIGHT)-1:0] tile_addr,
+    input  logic [$bits(cell_t)-1:0] tile_code,
+
+    // Status line (clk)
+    input  logic [12:0] score,
+    input  logic [12:0] length,
+    input  logic [12:0] speed,                       // Frames per move
+    input  logic game_over,
+
+    output logic [3:0] VGA_R,
+    output logic [3:0] VGA_G,
+    output logic [3:0] VGA_B,
+    output logic VGA_HS,
+    output logic VGA_VS
+);
+
+    // VGA timing for the selected mode (all modes are 60Hz)
+    localparam video_mode_t MODE = video_mode(VIDEO_MODE);
+    localparam int H_PIXELS = int'(MODE.h_pixels);
+    localparam int H_FP = int'(MODE.h_fp);
+    localparam int H_PULSE = int'(MODE.h_pulse);
+    localparam int H_BP = int'(MODE.h_bp);
+    localparam logic H_POL = MODE.h_pol;
+    localparam int V_PIXELS = int'(MODE.v_pixels);
+    localparam int V_FP = int'(MODE.v_fp);
+    localparam int V_PULSE = int'(MODE.v_pulse);
+    localparam int V_BP = int'(MODE.v_bp);
+    localparam logic V_POL = MODE.v_pol;
+    localparam int GRID_SIZE = int'(MODE.cell_size);
+
+    // Text layer: font pixels are 2x2 screen pixels, 4x4 in the modes with
+    // larger cells
+    localparam CHAR_SCALE = (GRID_SIZE >= 32) ? 4 : 2;
+
+    // Pixel clock generation on a PLL output, at the rate of the selected
+    // mode. The PLL is never reset so the pixel clock keeps running through
+    // a game reset.
+    logic pll_locked;
+    logic [1:0] pixel_reset_sync;
+
+    pixel_pll #(
+        .MULTIPLY_BY(MODE.pll_mul),
+        .DIVIDE_BY(MODE.pll_div)
+    ) pll_inst (
+        .areset(1'b0),
+        .inclk0(clk),
+        .c0(pixel_clk),
+        .locked(pll_locked)
+    );
+
+    // Pixel-domain reset: asserted asynchronously, released on pixel_clk
+    always_ff @(posedge pixel_clk or negedge reset_n) begin
+        if (~reset_n)
+            pixel_reset_sync <= 2'b00;
+        else
+            pixel_reset_sync <= {pixel_reset_sync[0], pll_locked};
+    end
+
+    assign pixel_reset_n = pixel_reset_sync[1];
+
+    // VGA controller signals
+    logic vga_disp_ena;
+    logic vga_h_sync;
+    logic vga_v_sync;
+    logic [31:0] vga_column;
+    logic [31:0] vga_row;
+
+    vga_controller #(
+        .h_pixels(H_PIXELS),
+        .h_fp(H_FP),
+        .h_pulse(H_PULSE),
+        .h_bp(H_BP),
+        .h_pol(H_POL),
+        .v_pixels(V_PIXELS),
+        .v_fp(V_FP),
+        .v_pulse(V_PULSE),
+        .v_bp(V_BP),
+        .v_pol(V_POL)
+    ) vga_inst (
+        .pixel_clk(pixel_clk),
+        .reset_n(pixel_reset_n),
+        .h_sync(vga_h_sync),
+        .v_sync(vga_v_sync),
+        .disp_ena(vga_disp_ena),
+        .column(vga_column),
+        .row(vga_row)
+    );
+
+    assign v_sync = vga_v_sync;
+
+    // Frame tick: start of the vertical sync pulse, brought over from the
+    // pixel domain. Vertical sync is held for whole lines, so a two-flop
+    // synchronizer on the level plus one flop for the edge is enough.
+    logic [2:0] v_sync_sync;
+
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n)
+            v_sync_sync <= {3{~V_POL}};
+        else
+            v_sync_sync <= {v_sync_sync[1:0], vga_v_sync};
+    end
+
+    assign frame_tick = (v_sync_sync[1] == V_POL) && (v_sync_sync[2] != V_POL);
+
+    // Status text: score, length and speed level, and GAME OVER
+    logic char_wr_en;
+    logic [10:0] char_wr_addr;
+    logic [6:0] char_wr_data;
+
+    text_writer #(
+        .H_PIXELS(H_PIXELS),
+        .V_PIXELS(V_PIXELS),
+        .CHAR_SCALE(CHAR_SCALE),
+        .GAME_SPEED_MAX(GAME_SPEED_MAX)
+    ) text_inst (
+        .clk(clk),
+        .reset_n(reset_n),
+        .update(frame_tick),
+        .score(score),
+        .length(length),
+        .speed(speed),
+        .game_over(game_over),
+        .wr_en(char_wr_en),
+        .wr_addr(char_wr_addr),
+        .wr_data(char_wr_data)
+    );
+
+    // Pixel pipeline: grid counters, sprite pixel, palette lookup and output
+    // are each registered, and VGA_HS/VGA_VS are delayed to match
+    snake_renderer #(
+        .GRID_SIZE(GRID_SIZE),
+        .GRID_WIDTH(GRID_WIDTH),
+        .GRID_HEIGHT(GRID_HEIGHT),
+        .H_POL(H_POL),
+        .V_POL(V_POL),
+        .COLOR_BLACK(COLOR_BLACK),
+        .COLOR_GREEN(COLOR_GREEN),
+        .COLOR_RED(COLOR_RED),
+        .COLOR_BLUE(COLOR_BLUE),
+        .COLOR_DARK_GREEN(COLOR_DARK_GREEN),
+        .COLOR_DARK_BLUE(COLOR_DARK_BLUE),
+        .COLOR_DARK_RED(COLOR_DARK_RED),
+        .COLOR_WHITE(COLOR_WHITE),
+        .COLOR_TEXT(COLOR_TEXT),
+        .CHAR_SCALE(CHAR_SCALE)
+    ) render_inst (
+        .pixel_clk(pixel_clk),
+        .reset_n(pixel_reset_n),
+        .disp_ena(vga_disp_ena),
+        .h_sync(vga_h_sync),
+        .v_sync(vga_v_sync),
+        .tile_addr(tile_addr),
+        .tile_code(tile_code),
+        .char_wr_clk(clk),
+        .char_wr_en(char_wr_en),
+        .char_wr_addr(char_wr_addr),
+        .char_wr_data(char_wr_data),
+        .VGA_R(VGA_R),
+        .VGA_G(VGA_G),
+        .VGA_B(VGA_B),
+        .VGA_HS(VGA_HS),
+        .VGA_VS(VGA_VS)
+    );
+
+endmodule
@@ -1,51 +1,66 @@
-module snake_game(
+module snake_game
+    import snake_pkg::*;
+#(
+    parameter video_mode_sel_t VIDEO_MODE = VIDEO_640X480, // Video mode, see snake_pkg
+    parameter [15:0] LFSR_SEED = 16'hACE1,          // Apple sequence seed
+    parameter SIM_SPEEDUP = 1                        // Simulation only: divides the frames per move
+)(
     input logic clk,           // 50MHz system clock
     input logic reset_n,       // Active low reset
     input logic [1:0] KEY,     // Direction control keys
-    input logic [9:0] SW,      // Switches, SW[0] controls border visibility
+    input logic [9:0] SW,      // Switches, SW[0] controls border visibility, SW[1] autopilot
     output logic [3:0] VGA_R,  // VGA Red channel
     output logic [3:0] VGA_G,  // VGA Green channel
     output logic [3:0] VGA_B,  // VGA Blue channel
     output logic VGA_HS,       // Horizontal sync
     output logic VGA_VS,        // Vertical sync
-	 output logic [$clog2(GRID_WIDTH*GRID_HEIGHT)-1:0] score
+	 output logic [$clog2(GRID_WIDTH*GRID_HEIGHT)-1:0] score,
+    output logic [31:0] turn_lat_min,  // Key pulse to head move, in clk cycles
+    output logic [31:0] turn_lat_max,
+    output logic [31:0] turn_lat_avg,
+    output logic [7:0] turns_dropped,  // Turns lost to a full turn queue
+
+    // Performance counters (Avalon-MM slave, see perf_counters)
+    input  logic [2:0] perf_address,
+    input  logic perf_read,
+    output logic [31:0] perf_readdata,
+    input  logic perf_write,
+    input  logic [31:0] perf_writedata
 );
 
-    // VGA Parameters for 1920x1080 @60Hz
-    parameter H_PIXELS = 640;
-    parameter H_FP = 16;
-    parameter H_PULSE = 96;
-    parameter H_BP = 48;
-    parameter V_PIXELS = 480;
-    parameter V_FP = 10;
-    parameter V_PULSE = 2;
-    parameter V_BP = 33;
+    // Screen size for the selected mode (snake_display has its timing)
+    localparam video_mode_t MODE = video_mode(VIDEO_MODE);
+    localparam int H_PIXELS = int'(MODE.h_pixels);
+    localparam int V_PIXELS = int'(MODE.v_pixels);
     
     // Game parameters
-    parameter GRID_SIZE = 20;                        // Size of each grid cell
-    parameter GRID_WIDTH = 32;                       // Number of grid cells horizontally (1920/20)
-    parameter GRID_HEIGHT = 24;                      // Number of grid cells vertically (1080/20)
+    localparam int GRID_SIZE = int'(MODE.cell_size); // Size of each grid cell
+    localparam GRID_WIDTH = H_PIXELS / GRID_SIZE;    // Number of grid cells horizontally (32 in every mode)
+    localparam GRID_HEIGHT = V_PIXELS / GRID_SIZE;   // Number of grid cells vertically (24, or 18 at 720p)
     parameter BORDER_SIZE = 1;                       // Border thickness in grid cells
     parameter INIT_SNAKE_LEN = 1;                    // Initial snake length
-    parameter GAME_SPEED_MAX = 12000000;             // Slowest game speed (higher = slower)
-    parameter GAME_SPEED_MIN = 3000000;              // Fastest game speed (lower = faster)
-    parameter GAME_SPEED_DECREMENT = 500000;         // Speed increase per apple eaten
-    parameter MAX_SNAKE_LENGTH = 100;
-    
-    // Color definitions (4-bit RGB)
-    parameter [11:0] COLOR_BLACK = 12'h000;          // Background
-    parameter [11:0] COLOR_GREEN = 12'h0F0;          // Snake
-    parameter [11:0] COLOR_RED = 12'hF00;            // Apple
-    parameter [11:0] COLOR_BLUE = 12'h00F;           // Border
-    parameter [11:0] COLOR_DARK_GREEN = 12'h080;     // Snake body
-    
-    // Direction definitions
-    typedef enum logic [1:0] {
-        DIR_RIGHT = 2'b00,
-        DIR_DOWN  = 2'b01,
-        DIR_LEFT  = 2'b10,
-        DIR_UP    = 2'b11
-    } direction_t;
+    parameter GAME_SPEED_MAX = 14;                   // Slowest game speed in frames per move (higher = slower)
+    parameter GAME_SPEED_MIN = 4;                    // Fastest game speed in frames per move (lower = faster)
+    parameter GAME_SPEED_DECREMENT = 1;              // Frames per move removed per apple eaten
+    
+    // Frames per move as played, SIM_SPEEDUP times fewer (at least one)
+    localparam SPEED_MAX = (GAME_SPEED_MAX / SIM_SPEEDUP > 1) ? GAME_SPEED_MAX / SIM_SPEEDUP : 1;
+    localparam SPEED_MIN = (GAME_SPEED_MIN / SIM_SPEEDUP > 1) ? GAME_SPEED_MIN / SIM_SPEEDUP : 1;
+    localparam SPEED_BITS = $clog2(GAME_SPEED_MAX) + 1;
+    parameter TURN_QUEUE_DEPTH = 4;                  // Key presses held for upcoming moves
+    
+    // Snake body storage: ring buffer of {y, x} cells, deep enough for the
+    // snake to fill the whole grid
+    localparam NUM_CELLS = GRID_WIDTH * GRID_HEIGHT;
+    localparam X_BITS = $clog2(GRID_WIDTH);
+    localparam Y_BITS = $clog2(GRID_HEIGHT);
+    localparam BODY_ADDR_BITS = $clog2(NUM_CELLS);
+    
+    // Grid positions at the width of a coordinate
+    localparam logic [X_BITS-1:0] X_LAST = X_BITS'(GRID_WIDTH - 1);
+    localparam logic [Y_BITS-1:0] Y_LAST = Y_BITS'(GRID_HEIGHT - 1);
+    localparam logic [X_BITS-1:0] X_MID = X_BITS'(GRID_WIDTH / 2);
+    localparam logic [Y_BITS-1:0] Y_MID = Y_BITS'(GRID_HEIGHT / 2);
     
     // Game state
     typedef enum logic [1:0] {
@@ -54,128 +69,252 @@ module snake_game(
         GAME_OVER
     } game_state_t;
     
-    // Pixel clock generation (25MHz for VGA)
+    // Pixel clock and its reset, from snake_display
     logic pixel_clk;
-    logic clk_div;
-    
-    always_ff @(posedge clk or negedge reset_n) begin
-        if (~reset_n) 
-            clk_div <= 0;
-        else
-            clk_div <= ~clk_div;
-    end
-    
-    assign pixel_clk = clk_div;
-    
-    // VGA controller signals
-    logic vga_disp_ena;
-    logic [31:0] vga_column;
-    logic [31:0] vga_row;
+    logic pixel_reset_n;
     
     // Game variables
     game_state_t game_state;
-    direction_t curr_direction, next_direction;
-	logic [$clog2(GRID_WIDTH)-1:0]  snake_x [0:GRID_WIDTH*GRID_HEIGHT-1];
-	logic [$clog2(GRID_HEIGHT)-1:0] snake_y [0:GRID_WIDTH*GRID_HEIGHT-1];
-    logic [100:0] snake_length;                // Current snake length
-    logic [$clog2(GRID_WIDTH)-1:0] apple_x;          // Apple X position
-    logic [$clog2(GRID_HEIGHT)-1:0] apple_y;         // Apple Y position
-    logic [$clog2(GAME_SPEED_MAX):0] move_counter;   // Counter for snake movement speed
-    logic [$clog2(GAME_SPEED_MAX):0] game_speed;     // Current game speed
+    direction_t curr_direction;                      // Direction of the last move
+    direction_t move_dir;                            // Direction of the pending move
+    logic [X_BITS-1:0] head_x;                       // Head X position
+    logic [Y_BITS-1:0] head_y;                       // Head Y position
+    logic [X_BITS-1:0] tail_x;                       // Tail X position (from body RAM)
+    logic [Y_BITS-1:0] tail_y;                       // Tail Y position (from body RAM)
+    logic [BODY_ADDR_BITS-1:0] head_ptr;             // Ring buffer slot holding the head
+    logic [BODY_ADDR_BITS-1:0] tail_ptr;             // Ring buffer slot holding the tail
+    logic [GRID_WIDTH-1:0] occupied [0:GRID_HEIGHT-1]; // One bit per cell covered by the snake
+    logic [BODY_ADDR_BITS:0] snake_length;           // Current snake length
+    logic move_done;                                 // Pulses after each committed move
+    logic move_grew;                                 // Last move grew the snake
+    logic [X_BITS-1:0] neck_x;                       // Head position before the last move
+    logic [Y_BITS-1:0] neck_y;
+    direction_t neck_dir;                            // Direction of the move before the last one
+    logic [X_BITS-1:0] vacated_x;                    // Tail position before the last move
+    logic [Y_BITS-1:0] vacated_y;
+    logic init_done;                                 // Pulses when IDLE has laid out the snake
+    logic [X_BITS-1:0] apple_x;                      // Apple X position
+    logic [Y_BITS-1:0] apple_y;                      // Apple Y position
+    logic [SPEED_BITS-1:0] game_speed;               // Current game speed (frames per move)
+    logic frame_tick;                                // Pulses once per frame, in vertical blanking
+    logic tiles_idle;                                // Tile map writes settled and shown
+    logic back_ready;                                // Tile map back page finished, ready to show
     logic game_tick;                                 // Pulses when snake should move
     logic collision_border;                          // Flag for border collision
     logic collision_self;                            // Flag for self collision
     logic apple_eaten;                               // Flag for apple eaten
     logic border_visible;                            // Border visibility flag
+    logic autopilot;                                 // Pathfinder steers, at top speed
 
     
     // LFSR for random number generation
     logic [15:0] lfsr;
     
-    // VGA Controller instantiation
-    vga_controller #(
-        .h_pixels(H_PIXELS),
-        .h_fp(H_FP),
-        .h_pulse(H_PULSE),
-        .h_bp(H_BP),
-        .v_pixels(V_PIXELS),
-        .v_fp(V_FP),
-        .v_pulse(V_PULSE),
-        .v_bp(V_BP)
-    ) vga_inst (
-        .pixel_clk(pixel_clk),
+    // Snake body ring buffer (M9K). Each move writes the new head one slot
+    // past head_ptr and, unless the snake grows, retires the tail by bumping
+    // tail_ptr, so a move costs the same no matter how long the snake is.
+    // The read port follows tail_ptr so the tail cell is always on hand.
+    logic body_wr_en;
+    logic [BODY_ADDR_BITS-1:0] body_wr_addr;
+    logic [X_BITS+Y_BITS-1:0] body_wr_data;
+    
+    dual_port_ram #(
+        .DATA_WIDTH(X_BITS + Y_BITS),
+        .ADDR_WIDTH(BODY_ADDR_BITS)
+    ) body_ram (
+        .wr_clk(clk),
+        .wr_en(body_wr_en),
+        .wr_addr(body_wr_addr),
+        .wr_data(body_wr_data),
+        .rd_clk(clk),
+        .rd_addr(tail_ptr),
+        .rd_data({tail_y, tail_x})
+    );
+    
+    // Direction of the move out of each ring slot, for the tail's sprite.
+    // It is written when the head leaves the slot, so it is known for every
+    // segment but the head, and read at tail_ptr like the body RAM.
+    logic [1:0] tail_dir;
+    
+    dual_port_ram #(
+        .DATA_WIDTH(2),
+        .ADDR_WIDTH(BODY_ADDR_BITS)
+    ) exit_ram (
+        .wr_clk(clk),
+        .wr_en(body_wr_en),
+        .wr_addr(body_wr_addr - 1'b1),
+        .wr_data(game_state == IDLE ? DIR_RIGHT : move_dir),
+        .rd_clk(clk),
+        .rd_addr(tail_ptr),
+        .rd_data(tail_dir)
+    );
+    
+    // Next head position and collision checks for the pending move. The
+    // self-collision test is a single bitmap lookup; the tail cell is allowed
+    // because it is vacated in the same move unless the snake grows.
+    logic [X_BITS-1:0] next_x;
+    logic [Y_BITS-1:0] next_y;
+    logic hit_border, hit_self, grows;
+    
+    always_comb begin
+        next_x = head_x;
+        next_y = head_y;
+        case (move_dir)
+            DIR_RIGHT: next_x = (head_x == X_LAST) ? '0 : head_x + 1'b1;
+            DIR_LEFT:  next_x = (head_x == 0) ? X_LAST : head_x - 1'b1;
+            DIR_DOWN:  next_y = (head_y == Y_LAST) ? '0 : head_y + 1'b1;
+            DIR_UP:    next_y = (head_y == 0) ? Y_LAST : head_y - 1'b1;
+        endcase
+        
+        hit_border = border_visible && (
+            (int'(head_x) == BORDER_SIZE - 1 && move_dir == DIR_LEFT) ||
+            (int'(head_x) == GRID_WIDTH - BORDER_SIZE && move_dir == DIR_RIGHT) ||
+            (int'(head_y) == BORDER_SIZE - 1 && move_dir == DIR_UP) ||
+            (int'(head_y) == GRID_HEIGHT - BORDER_SIZE && move_dir == DIR_DOWN)
+        );
+        
+        grows = (next_x == apple_x && next_y == apple_y);
+        
+        hit_self = occupied[next_y][next_x] &&
+                   !(next_x == tail_x && next_y == tail_y && !grows);
+    end
+    
+    // Body RAM write port: lay out the initial snake in IDLE, then write one
+    // new head per move
+    logic [BODY_ADDR_BITS-1:0] init_idx;
+    
+    always_comb begin
+        body_wr_en = 1'b0;
+        body_wr_addr = head_ptr + 1'b1;
+        body_wr_data = {next_y, next_x};
+        if (game_state == IDLE) begin
+            body_wr_en = 1'b1;
+            body_wr_addr = init_idx;
+            body_wr_data = {Y_MID, X_BITS'(GRID_WIDTH / 2 - INIT_SNAKE_LEN + 1 + int'(init_idx))};
+        end else if (game_state == RUNNING && game_tick && !hit_border && !hit_self) begin
+            body_wr_en = 1'b1;
+        end
+    end
+    
+    // Apple placement: a uniformly random free cell, chosen in a fixed
+    // number of cycles after each apple is eaten
+    logic place_busy, place_done, place_found;
+    logic [X_BITS-1:0] place_x;
+    logic [Y_BITS-1:0] place_y;
+    logic [Y_BITS-1:0] place_row;
+    
+    apple_placer #(
+        .GRID_WIDTH(GRID_WIDTH),
+        .GRID_HEIGHT(GRID_HEIGHT),
+        .BORDER_SIZE(BORDER_SIZE)
+    ) placer_inst (
+        .clk(clk),
         .reset_n(reset_n),
-        .h_sync(VGA_HS),
-        .v_sync(VGA_VS),
-        .disp_ena(vga_disp_ena),
-        .column(vga_column),
-        .row(vga_row)
+        .start(apple_eaten),
+        .rand_in(lfsr),
+        .row_addr(place_row),
+        .row_occupied(occupied[place_row]),
+        .busy(place_busy),
+        .done(place_done),
+        .found(place_found),
+        .apple_x(place_x),
+        .apple_y(place_y)
     );
     
-    // LFSR implementation for pseudo-random numbers
+    // Autopilot pathfinder: re-plans after every move, new game and new
+    // apple, and always finishes long before the next move is due
+    logic path_busy, path_valid;
+    direction_t path_dir;
+    logic [Y_BITS-1:0] path_row;
+    
+    snake_pathfinder #(
+        .GRID_WIDTH(GRID_WIDTH),
+        .GRID_HEIGHT(GRID_HEIGHT),
+        .BORDER_SIZE(BORDER_SIZE)
+    ) path_inst (
+        .clk(clk),
+        .reset_n(reset_n),
+        .start(move_done || init_done || (place_done && place_found)),
+        .border_visible(border_visible),
+        .head_x(head_x),
+        .head_y(head_y),
+        .apple_x(apple_x),
+        .apple_y(apple_y),
+        .row_addr(path_row),
+        .row_occupied(occupied[path_row]),
+        .busy(path_busy),
+        .valid(path_valid),
+        .dir(path_dir)
+    );
+    
+    // LFSR implementation for pseudo-random numbers. It steps once per
+    // game_tick, so the apple sequence depends only on the seed and the
+    // moves played, and the C++ model (sim/snake_model.cpp) can follow it.
     always_ff @(posedge clk or negedge reset_n) begin
         if (~reset_n) begin
-            lfsr <= 16'hACE1;  // Initial seed
-        end else begin
+            lfsr <= LFSR_SEED;  // Initial seed
+        end else if (game_tick) begin
             lfsr <= {lfsr[14:0], lfsr[15] ^ lfsr[13] ^ lfsr[12] ^ lfsr[10]};
         end
     end
     
-    // Game tick generator
+    // Game tick and direction control (see snake_control). A move falls due
+    // every game_speed frames (every SPEED_MIN frames under autopilot) and
+    // is taken once the tile map has flipped, so the game only steps during
+    // vertical blanking. The autopilot's answer is for the current head and
+    // is used as is; key presses are queued only while it is off.
+    //
+    // A move's state is committed, for the performance counters, when the
+    // tile map back page holding it is finished (it is shown at the next
+    // frame tick).
+    logic back_ready_d;
+    
     always_ff @(posedge clk or negedge reset_n) begin
-        if (~reset_n) begin
-            move_counter <= 0;
-            game_tick <= 0;
-        end else begin
-            if (move_counter >= game_speed) begin
-                move_counter <= 0;
-                game_tick <= 1;
-            end else begin
-                move_counter <= move_counter + 1;
-                game_tick <= 0;
-            end
-        end
+        if (~reset_n)
+            back_ready_d <= 1'b0;
+        else
+            back_ready_d <= back_ready;
     end
     
-    // Direction control - using asynchronous reset
-			always_ff @(posedge clk or negedge reset_n) begin
-				 if (~reset_n) begin
-					  // Reset on global reset or game over
-					  curr_direction <= DIR_RIGHT;
-					  next_direction <= DIR_RIGHT;
-				 end else if (game_state == RUNNING) begin
-					  // Handle key presses
-					  if (KEY[0]) begin
-							// Rotate clockwise
-							case (curr_direction)
-								 DIR_UP:    next_direction <= DIR_RIGHT;
-								 DIR_RIGHT: next_direction <= DIR_DOWN;
-								 DIR_DOWN:  next_direction <= DIR_LEFT;
-								 DIR_LEFT:  next_direction <= DIR_UP;
-							endcase
-					  end else if (KEY[1]) begin
-							// Rotate counter-clockwise
-							case (curr_direction)
-								 DIR_UP:    next_direction <= DIR_LEFT;
-								 DIR_LEFT:  next_direction <= DIR_DOWN;
-								 DIR_DOWN:  next_direction <= DIR_RIGHT;
-								 DIR_RIGHT: next_direction <= DIR_UP;
-							endcase
-					  end
-					// Immediate direction update on pulse
-					if (game_tick) begin
-						curr_direction <= next_direction;
-					end
-				 end
-			end
-
+    snake_control #(
+        .SPEED_BITS(SPEED_BITS),
+        .TURN_QUEUE_DEPTH(TURN_QUEUE_DEPTH)
+    ) control_inst (
+        .clk(clk),
+        .reset_n(reset_n),
+        .frame_tick(frame_tick),
+        .speed(autopilot ? SPEED_BITS'(SPEED_MIN) : game_speed),
+        .ready(tiles_idle && !(autopilot && path_busy)),
+        .game_tick(game_tick),
+        .KEY(KEY),
+        .turns_on(game_state == RUNNING && !autopilot),
+        .steer_valid(autopilot && path_valid),
+        .steer_dir(path_dir),
+        .take(game_state == RUNNING && game_tick),
+        .move_ok(!hit_border && !hit_self),
+        .move_dir(move_dir),
+        .curr_direction(curr_direction),
+        .turn_lat_min(turn_lat_min),
+        .turn_lat_max(turn_lat_max),
+        .turn_lat_avg(turn_lat_avg),
+        .turns_dropped(turns_dropped),
+        .move_commit(back_ready && !back_ready_d),
+        .apple(apple_eaten),
+        .perf_address(perf_address),
+        .perf_read(perf_read),
+        .perf_readdata(perf_readdata),
+        .perf_write(perf_write),
+        .perf_writedata(perf_writedata)
+    );
     
-    // Border visibility toggle - using asynchronous reset
+    // Border visibility and autopilot switches - using asynchronous reset
     always_ff @(posedge clk or negedge reset_n) begin
         if (~reset_n) begin
             border_visible <= 1'b1;  // Border visible by default
+            autopilot <= 1'b0;
         end else begin
             border_visible <= SW[0];  // SW[0] controls border visibility
+            autopilot <= SW[1];       // SW[1] hands the snake to the pathfinder
         end
     end
     
@@ -184,25 +323,31 @@ module snake_game(
         if (~reset_n) begin
             // Initialize game state
             game_state <= IDLE;
-            snake_length <= INIT_SNAKE_LEN;
-            game_speed <= GAME_SPEED_MAX;
+            snake_length <= (BODY_ADDR_BITS+1)'(INIT_SNAKE_LEN);
+            game_speed <= SPEED_BITS'(SPEED_MAX);
             score <= 0;
             
-            // Initialize snake position (center of screen, pointing right)
-            snake_x[0] <= GRID_WIDTH / 2;
-            snake_y[0] <= GRID_HEIGHT / 2;
-            // snake_x[1] <= (GRID_WIDTH / 2) - 1;
-            // snake_y[1] <= GRID_HEIGHT / 2;
-				
-			   // Clear all other segments to unused positions (e.g., 0)
-				for (int i = 1; i < MAX_SNAKE_LENGTH; i++) begin
-					snake_x[i] <= 0;
-					snake_y[i] <= 0;
-				end
+            // Snake is laid out in IDLE (center of screen, pointing right)
+            head_x <= X_MID;
+            head_y <= Y_MID;
+            head_ptr <= 0;
+            tail_ptr <= 0;
+            init_idx <= 0;
+            init_done <= 0;
+            for (int y = 0; y < GRID_HEIGHT; y++)
+                occupied[y] <= '0;
+            
+            move_done <= 0;
+            move_grew <= 0;
+            neck_x <= 0;
+            neck_y <= 0;
+            neck_dir <= DIR_RIGHT;
+            vacated_x <= 0;
+            vacated_y <= 0;
             
             // Initialize apple position
-            apple_x <= (GRID_WIDTH / 4);
-            apple_y <= (GRID_HEIGHT / 4);
+            apple_x <= X_BITS'(GRID_WIDTH / 4);
+            apple_y <= Y_BITS'(GRID_HEIGHT / 4);
             
             apple_eaten <= 0;
             collision_border <= 0;
@@ -212,180 +357,331 @@ module snake_game(
             apple_eaten <= 0;
             collision_border <= 0;
             collision_self <= 0;
+            move_done <= 0;
+            init_done <= 0;
+            
+            // New apple from the placer (left under the snake if the board
+            // is full)
+            if (place_done && place_found) begin
+                apple_x <= place_x;
+                apple_y <= place_y;
+            end
             
             case (game_state)
                 IDLE: begin
-                    // Start game
-                    game_state <= RUNNING;
+                    // Lay out the initial snake one segment per cycle, tail
+                    // first, then start the game
+                    occupied[Y_MID][GRID_WIDTH / 2 - INIT_SNAKE_LEN + 1 + int'(init_idx)] <= 1'b1;
+                    if (init_idx == BODY_ADDR_BITS'(INIT_SNAKE_LEN - 1)) begin
+                        head_x <= X_MID;
+                        head_y <= Y_MID;
+                        head_ptr <= init_idx;
+                        tail_ptr <= 0;
+                        init_idx <= 0;
+                        init_done <= 1;
+                        game_state <= RUNNING;
+                    end else begin
+                        init_idx <= init_idx + 1'b1;
+                    end
                 end
                 
                 RUNNING: begin
                     if (game_tick) begin
-                        // Move snake body (shift all segments)
-                       for (int i = 0; i < MAX_SNAKE_LENGTH; i++) begin
-										if (i < snake_length) begin
-											if (i == 0) begin
-										// Move head based on direction (handled in case statement)
-										end else begin
-											snake_x[i] <= snake_x[i-1];
-											snake_y[i] <= snake_y[i-1];
-										end
-									end
-								end
-                        
-                        // Move snake head based on direction
-                        case (curr_direction)
-                            DIR_RIGHT: snake_x[0] <= snake_x[0] + 1;
-                            DIR_LEFT:  snake_x[0] <= snake_x[0] - 1;
-                            DIR_DOWN:  snake_y[0] <= snake_y[0] + 1;
-                            DIR_UP:    snake_y[0] <= snake_y[0] - 1;
-                        endcase
-                        
-                        // Check for border collision
-                        if (border_visible && (
-                            (snake_x[0] == BORDER_SIZE - 1 && curr_direction == DIR_LEFT) ||
-                            (snake_x[0] == GRID_WIDTH - BORDER_SIZE && curr_direction == DIR_RIGHT) ||
-                            (snake_y[0] == BORDER_SIZE - 1 && curr_direction == DIR_UP) ||
-                            (snake_y[0] == GRID_HEIGHT - BORDER_SIZE && curr_direction == DIR_DOWN)
-                        )) begin
+                        if (hit_border) begin
                             collision_border <= 1;
                             game_state <= GAME_OVER;
+                        end else if (hit_self) begin
+                            collision_self <= 1;
+                            game_state <= GAME_OVER;
+                        end else begin
+                            // Advance the head; retire the tail unless growing.
+                            // The tail bit is cleared before the head bit is
+                            // set so following the tail keeps the cell marked.
+                            head_x <= next_x;
+                            head_y <= next_y;
+                            head_ptr <= head_ptr + 1'b1;
+                            if (!grows) begin
+                                tail_ptr <= tail_ptr + 1'b1;
+                                occupied[tail_y][tail_x] <= 1'b0;
+                            end
+                            occupied[next_y][next_x] <= 1'b1;
+                            
+                            // Remember what changed for the tile map writer
+                            move_done <= 1;
+                            move_grew <= grows;
+                            neck_x <= head_x;
+                            neck_y <= head_y;
+                            neck_dir <= curr_direction;
+                            vacated_x <= tail_x;
+                            vacated_y <= tail_y;
                         end
                         
-                        // Check for self collision 
-                        for (int i = 1; i < MAX_SNAKE_LENGTH; i++) begin
-									if (snake_x[0] == snake_x[i] && snake_y[0] == snake_y[i]) begin
-										collision_self <= 1;
-										game_state <= GAME_OVER;
-									end
-								end
-                        
-                        // Check if apple is eaten
-								if (snake_x[0] == apple_x && snake_y[0] == apple_y) begin
-									 // Declare variables at the beginning of the block
-									 logic valid_position;
-									 logic [$clog2(GRID_WIDTH)-1:0] new_x;
-									 logic [$clog2(GRID_HEIGHT)-1:0] new_y;
-
-									 apple_eaten <= 1;
-									 
-									 // Increase snake length
-									 if (snake_length < GRID_WIDTH*GRID_HEIGHT - 1) begin
-										  snake_length <= snake_length + 1;
-									 end
-									 
-									 // Increase score
-									 score <= score + 1;
-									 
-									 // Generate new apple position
-									 // Use LFSR to generate random positions
-									 new_x = (lfsr[7:0] % (GRID_WIDTH - 2*BORDER_SIZE)) + BORDER_SIZE;
-									 new_y = (lfsr[15:8] % (GRID_HEIGHT - 2*BORDER_SIZE)) + BORDER_SIZE;
-									 
-									 // Check if position is valid (not on snake)
-									 valid_position = 1;
-									 for (int i = 0; i < MAX_SNAKE_LENGTH; i++) begin
-										if (new_x == snake_x[i] && new_y == snake_y[i]) begin
-											valid_position = 0;
-											end
-									 end
-									 
-									 if (valid_position) begin
-										  apple_x <= new_x;
-										  apple_y <= new_y;
-									 end else begin
-										  // If invalid, try a different position by shifting
-										  apple_x <= ((new_x + 3) % (GRID_WIDTH - 2*BORDER_SIZE)) + BORDER_SIZE;
-										  apple_y <= ((new_y + 5) % (GRID_HEIGHT - 2*BORDER_SIZE)) + BORDER_SIZE;
-									 end
-									 
-									 // Increase game speed (decrease delay)
-									 if (game_speed > GAME_SPEED_MIN + GAME_SPEED_DECREMENT) begin
-										  game_speed <= game_speed - GAME_SPEED_DECREMENT;
-									 end
-								end
+                        // Apple eaten: grow, score, speed up and ask the
+                        // placer for a new apple
+                        if (grows && !hit_border && !hit_self) begin
+                            apple_eaten <= 1;
+                            
+                            // Increase snake length
+                            if (snake_length < (BODY_ADDR_BITS+1)'(NUM_CELLS)) begin
+                                snake_length <= snake_length + 1'b1;
+                            end
+                            
+                            // Increase score
+                            score <= score + 1'b1;
+                            
+                            // Increase game speed (decrease delay)
+                            if (game_speed >= SPEED_BITS'(SPEED_MIN + GAME_SPEED_DECREMENT)) begin
+                                game_speed <= game_speed - SPEED_BITS'(GAME_SPEED_DECREMENT);
+                            end
+                        end
                     end
                 end
                 
                 GAME_OVER: begin
                     // Reset the game after a brief delay
-                    if (move_counter >= GAME_SPEED_MAX) begin
+                    if (game_tick) begin
                         // Reset game state
                         game_state <= IDLE;
-                        snake_length <= INIT_SNAKE_LEN;
-                        game_speed <= GAME_SPEED_MAX;
+                        snake_length <= (BODY_ADDR_BITS+1)'(INIT_SNAKE_LEN);
+                        game_speed <= SPEED_BITS'(SPEED_MAX);
                         score <= 0;
+                        for (int y = 0; y < GRID_HEIGHT; y++)
+                            occupied[y] <= '0;
                         
                     end
                 end
+                
+                default: game_state <= IDLE;
             endcase
         end
     end
     
-    // VGA Output
-    logic [11:0] pixel_color;
-    logic is_border, is_snake_head, is_snake_body, is_apple;
-    logic [$clog2(GRID_WIDTH)-1:0] grid_x;
-    logic [$clog2(GRID_HEIGHT)-1:0] grid_y;
+    // Tile map (M9K): one cell code (kind and sprite orientation, see
+    // cell_t) per grid cell, addressed {page, y, x}. The
+    // game side rewrites only the cells a move touches; the VGA side reads it
+    // on pixel_clk, so drawing costs the same for any snake length and the
+    // two sides only share this memory.
+    //
+    // The map is double buffered. Moves are drawn into the back page, and the
+    // pages are swapped on the next frame tick, i.e. in vertical blanking, so
+    // a frame never shows half a move. After a swap the same dirty cells are
+    // replayed into the new back page to bring it level with the front.
+    localparam TILE_ADDR_BITS = X_BITS + Y_BITS;
+    
+    logic tile_wr_en;
+    logic [TILE_ADDR_BITS:0] tile_wr_addr;
+    cell_t tile_wr_code;
+    logic [TILE_ADDR_BITS-1:0] render_addr;
+    logic [TILE_ADDR_BITS:0] tile_rd_addr;
+    logic [$bits(cell_t)-1:0] tile_rd_code;
+    
+    logic front_page;                                // Page being scanned out
+    logic back_dirty;                                // Back page holds a move not yet shown
+    logic apple_redraw;                              // Last move's dirty set includes an apple
+    logic [1:0] front_page_sync;                     // front_page in the pixel domain
+    
+    always_ff @(posedge pixel_clk or negedge pixel_reset_n) begin
+        if (~pixel_reset_n)
+            front_page_sync <= 2'b00;
+        else
+            front_page_sync <= {front_page_sync[0], front_page};
+    end
+    
+    assign tile_rd_addr = {front_page_sync[1], render_addr};
+    
+    dual_port_ram #(
+        .DATA_WIDTH($bits(cell_t)),
+        .ADDR_WIDTH(TILE_ADDR_BITS + 1)
+    ) tile_map (
+        .wr_clk(clk),
+        .wr_en(tile_wr_en),
+        .wr_addr(tile_wr_addr),
+        .wr_data(tile_wr_code),
+        .rd_clk(pixel_clk),
+        .rd_addr(tile_rd_addr),
+        .rd_data(tile_rd_code)
+    );
+    
+    function automatic logic is_border_cell(input logic [X_BITS-1:0] x,
+                                            input logic [Y_BITS-1:0] y);
+        return int'(x) < BORDER_SIZE || int'(x) >= GRID_WIDTH - BORDER_SIZE ||
+               int'(y) < BORDER_SIZE || int'(y) >= GRID_HEIGHT - BORDER_SIZE;
+    endfunction
+    
+    // Dirty cells left by the last move, written one per cycle. Order matters
+    // when cells coincide: the tail is cleared after the neck is redrawn (a
+    // length-1 snake) and before the new head is drawn (following the tail),
+    // and the new tail, which may be the neck, is redrawn as a tail between
+    // them.
+    logic dirty_neck, dirty_tail, dirty_end, dirty_head, dirty_apple;
+    
+    // Repaint of both pages from the game state: every cell after a new
+    // snake is laid out, the border cells when the border is toggled. The
+    // body's orientation is not kept anywhere but the tile map, so the full
+    // repaint assumes the snake is as laid out, straight and pointing right,
+    // and the border repaint leaves the rest of the map alone.
+    logic sweep_active;
+    logic sweep_all;
+    logic [TILE_ADDR_BITS:0] sweep_addr;
+    logic border_drawn;
+    logic sweep_page;
+    logic [X_BITS-1:0] sweep_x;
+    logic [Y_BITS-1:0] sweep_y;
+    
+    assign {sweep_page, sweep_y, sweep_x} = sweep_addr;
     
-    // Determine what to display at current pixel
     always_comb begin
-        // Default - black background
-        pixel_color = COLOR_BLACK;
-        
-        // Calculate grid position of current pixel
-        grid_x = vga_column / GRID_SIZE;
-        grid_y = vga_row / GRID_SIZE;
-        
-        // Check if current pixel is in the border
-        is_border = border_visible && (
-            grid_x < BORDER_SIZE || 
-            grid_x >= GRID_WIDTH - BORDER_SIZE || 
-            grid_y < BORDER_SIZE || 
-            grid_y >= GRID_HEIGHT - BORDER_SIZE
-        );
-        
-        // Check if current pixel is the snake head
-        is_snake_head = (grid_x == snake_x[0] && grid_y == snake_y[0]);
+        logic [X_BITS-1:0] wx;
+        logic [Y_BITS-1:0] wy;
+        logic wp;
         
-        // Check if current pixel is snake body
-        is_snake_body = 0;
-        for (int i = 1; i < MAX_SNAKE_LENGTH; i++) begin
-            if (grid_x == snake_x[i] && grid_y == snake_y[i]) begin
-                is_snake_body = 1;
-            end
+        tile_wr_en = 1'b1;
+        wp = ~front_page;
+        wx = sweep_x;
+        wy = sweep_y;
+        tile_wr_code = CELL_EMPTY;
+        if (dirty_neck) begin
+            wx = neck_x;
+            wy = neck_y;
+            tile_wr_code = '{TILE_BODY, neck_dir, curr_direction};
+        end else if (dirty_tail) begin
+            wx = vacated_x;
+            wy = vacated_y;
+            tile_wr_code = CELL_EMPTY;
+        end else if (dirty_end) begin
+            wx = tail_x;
+            wy = tail_y;
+            tile_wr_code = '{TILE_TAIL, direction_t'(tail_dir), direction_t'(tail_dir)};
+        end else if (dirty_head) begin
+            wx = head_x;
+            wy = head_y;
+            tile_wr_code = '{TILE_HEAD, curr_direction, curr_direction};
+        end else if (dirty_apple) begin
+            wx = apple_x;
+            wy = apple_y;
+            tile_wr_code = CELL_APPLE;
+        end else if (sweep_active) begin
+            wp = sweep_page;
+            tile_wr_en = sweep_all || is_border_cell(sweep_x, sweep_y);
+            if (int'(sweep_x) >= GRID_WIDTH || int'(sweep_y) >= GRID_HEIGHT)
+                tile_wr_code = CELL_EMPTY;
+            else if (sweep_x == head_x && sweep_y == head_y)
+                tile_wr_code = '{TILE_HEAD, curr_direction, curr_direction};
+            else if (sweep_x == tail_x && sweep_y == tail_y && occupied[sweep_y][sweep_x])
+                tile_wr_code = '{TILE_TAIL, direction_t'(tail_dir), direction_t'(tail_dir)};
+            else if (occupied[sweep_y][sweep_x])
+                tile_wr_code = '{TILE_BODY, DIR_RIGHT, DIR_RIGHT};
+            else if (sweep_x == apple_x && sweep_y == apple_y)
+                tile_wr_code = CELL_APPLE;
+        end else begin
+            tile_wr_en = 1'b0;
         end
         
-        // Check if current pixel is the apple
-        is_apple = (grid_x == apple_x && grid_y == apple_y);
+        // The border is drawn over anything the snake leaves on it
+        if (border_visible && is_border_cell(wx, wy))
+            tile_wr_code = CELL_BORDER;
         
-        // Set pixel color based on what it represents
-        if (is_border) begin
-            pixel_color = COLOR_BLUE;
-        end else if (is_snake_head) begin
-            pixel_color = COLOR_GREEN;
-        end else if (is_snake_body) begin
-            pixel_color = COLOR_DARK_GREEN;
-        end else if (is_apple) begin
-            pixel_color = COLOR_RED;
-        end
+        tile_wr_addr = {wp, wy, wx};
     end
     
-    // Drive VGA outputs - using asynchronous reset
-    always_ff @(posedge pixel_clk or negedge reset_n) begin
+    assign tiles_idle = !dirty_neck && !dirty_tail && !dirty_end && !dirty_head && !dirty_apple &&
+                        !place_busy && !sweep_active && !back_dirty;
+    
+    // The back page holds the whole move (and any new apple)
+    assign back_ready = back_dirty && !dirty_neck && !dirty_tail && !dirty_end && !dirty_head &&
+                        !dirty_apple && !place_busy && !sweep_active;
+    
+    always_ff @(posedge clk or negedge reset_n) begin
         if (~reset_n) begin
-            VGA_R <= 4'h0;
-            VGA_G <= 4'h0;
-            VGA_B <= 4'h0;
-        end else if (vga_disp_ena) begin
-            VGA_R <= pixel_color[11:8];
-            VGA_G <= pixel_color[7:4];
-            VGA_B <= pixel_color[3:0];
+            dirty_neck <= 0;
+            dirty_tail <= 0;
+            dirty_end <= 0;
+            dirty_head <= 0;
+            dirty_apple <= 0;
+            sweep_active <= 0;
+            sweep_all <= 0;
+            sweep_addr <= 0;
+            border_drawn <= 1'b1;
+            front_page <= 0;
+            back_dirty <= 0;
+            apple_redraw <= 0;
         end else begin
-            VGA_R <= 4'h0;
-            VGA_G <= 4'h0;
-            VGA_B <= 4'h0;
+            // Retire the cell written this cycle
+            if (dirty_neck)
+                dirty_neck <= 0;
+            else if (dirty_tail)
+                dirty_tail <= 0;
+            else if (dirty_end)
+                dirty_end <= 0;
+            else if (dirty_head)
+                dirty_head <= 0;
+            else if (dirty_apple)
+                dirty_apple <= 0;
+            else if (sweep_active) begin
+                sweep_addr <= sweep_addr + 1'b1;
+                if (sweep_addr == '1)
+                    sweep_active <= 0;
+            end
+            
+            // Queue the cells touched by a new move or apple
+            if (move_done) begin
+                dirty_neck <= 1;
+                dirty_tail <= !move_grew;
+                dirty_end <= 1;
+                dirty_head <= 1;
+                back_dirty <= 1;
+                apple_redraw <= 0;
+            end
+            if (place_done && place_found) begin
+                dirty_apple <= 1;
+                apple_redraw <= 1;
+            end
+            
+            // Show the finished move and replay it into the other page
+            if (frame_tick && back_ready) begin
+                front_page <= ~front_page;
+                back_dirty <= 0;
+                dirty_neck <= 1;
+                dirty_tail <= !move_grew;
+                dirty_end <= 1;
+                dirty_head <= 1;
+                dirty_apple <= apple_redraw;
+            end
+            
+            if (init_done || border_visible != border_drawn) begin
+                sweep_active <= 1;
+                sweep_all <= init_done || (sweep_active && sweep_all);
+                sweep_addr <= 0;
+                border_drawn <= border_visible;
+            end
         end
     end
+    
+    // Video: VGA timing, frame tick, status text and the pixel pipeline,
+    // which reads the front page of the tile map
+    snake_display #(
+        .VIDEO_MODE(VIDEO_MODE),
+        .GRID_WIDTH(GRID_WIDTH),
+        .GRID_HEIGHT(GRID_HEIGHT),
+        .GAME_SPEED_MAX(SPEED_MAX)
+    ) display_inst (
+        .clk(clk),
+        .reset_n(reset_n),
+        .pixel_clk(pixel_clk),
+        .pixel_reset_n(pixel_reset_n),
+        .v_sync(),
+        .frame_tick(frame_tick),
+        .tile_addr(render_addr),
+        .tile_code(tile_rd_code),
+        .score(13'(score)),
+        .length(13'(snake_length)),
+        .speed(13'(game_speed)),
+        .game_over(game_state == GAME_OVER),
+        .VGA_R(VGA_R),
+        .VGA_G(VGA_G),
+        .VGA_B(VGA_B),
+        .VGA_HS(VGA_HS),
+        .VGA_VS(VGA_VS)
+    );
 
 endmodule
\ No newline at end of file
@@ -1,4 +1,13 @@
-module snake_game_tb();
+// snake_game for FRAMES video frames, with SIM_SPEEDUP cutting the frames
+// per move (14 gives a move every frame), turning with single-clock KEY
+// pulses a few frames apart. Checks the turn latency statistics (one
+// sample per turn, none dropped, and each between 0 and one frame) and the
+// performance counters (frames, moves and collision checks counted, and
+// COMMIT_MAX at least COMMIT_LAST).
+module snake_game_tb #(
+    parameter FRAMES = 12,
+    parameter SIM_SPEEDUP = 14                       // See snake_game
+)();
     // Testbench signals
     logic clk;
     logic reset_n;
@@ -9,9 +18,27 @@ module snake_game_tb();
     logic [3:0] VGA_B;
     logic VGA_HS;
     logic VGA_VS;
-    
+    logic [9:0] score;
+    logic [31:0] turn_lat_min, turn_lat_max, turn_lat_avg;
+    logic [7:0] turns_dropped;
+    logic [2:0] perf_address;
+    logic perf_read, perf_write;
+    logic [31:0] perf_readdata, perf_writedata;
+
+    localparam snake_pkg::video_mode_t MODE = snake_pkg::video_mode(snake_pkg::VIDEO_640X480);
+
+    // clk cycles per frame
+    localparam FRAME_CYCLES =
+        (MODE.h_pixels + MODE.h_fp + MODE.h_pulse + MODE.h_bp) *
+        (MODE.v_pixels + MODE.v_fp + MODE.v_pulse + MODE.v_bp) * MODE.pll_div / MODE.pll_mul;
+
+    // Turns, KEY[1] then KEY[0] alternately, pressed early in these frames
+    localparam int TURN_FRAMES [4] = '{2, 4, 6, 8};
+
     // Instantiate the snake game module
-    snake_game dut(
+    snake_game #(
+        .SIM_SPEEDUP(SIM_SPEEDUP)
+    ) dut (
         .clk(clk),
         .reset_n(reset_n),
         .KEY(KEY),
@@ -20,55 +47,104 @@ module snake_game_tb();
         .VGA_G(VGA_G),
         .VGA_B(VGA_B),
         .VGA_HS(VGA_HS),
-        .VGA_VS(VGA_VS)
+        .VGA_VS(VGA_VS),
+        .score(score),
+        .turn_lat_min(turn_lat_min),
+        .turn_lat_max(turn_lat_max),
+        .turn_lat_avg(turn_lat_avg),
+        .turns_dropped(turns_dropped),
+        .perf_address(perf_address),
+        .perf_read(perf_read),
+        .perf_readdata(perf_readdata),
+        .perf_write(perf_write),
+        .perf_writedata(perf_writedata)
     );
-    
+
+    // Performance counter readout
+    perf_uart_model uart (
+        .clk(clk),
+        .avm_address(perf_address),
+        .avm_read(perf_read),
+        .avm_readdata(perf_readdata),
+        .avm_write(perf_write),
+        .avm_writedata(perf_writedata)
+    );
+
     // Clock generation
     initial begin
         clk = 0;
         forever #10 clk = ~clk; // 50MHz clock
     end
-    
+
     // Test sequence
     initial begin
+        int turns;
+        int errors;
+
         // Initialize signals
         reset_n = 0;
-        KEY = 2'b11; // No buttons pressed
+        KEY = 2'b00; // No key pulses (KEY takes the debounced, active-high pulses)
         SW = 10'b0000000001; // Border visible
-        
+        turns = 0;
+        errors = 0;
+
         // Apply reset
         #20 reset_n = 1;
-        
-        // Wait for game to start
-        #1000;
-        
-        // Test button presses - turn left (counter-clockwise)
-        #1000 KEY[1] = 0; // Press KEY[1]
-        #50 KEY[1] = 1;   // Release KEY[1]
-        
-        // Wait for snake to move in the new direction
-        #3000;
-        
-        // Test button presses - turn right (clockwise)
-        #1000 KEY[0] = 0; // Press KEY[0]
-        #50 KEY[0] = 1;   // Release KEY[0]
-        
-        // Wait for snake to move in the new direction
-        #3000;
-        
-        // Toggle border visibility
-        SW[0] = 0; // Hide border
-        
-        // Continue simulation
-        #10000;
-        
+
+        for (int frame = 0; frame < FRAMES; frame++) begin
+            // End of vertical sync: this frame's move has been taken
+            wait (VGA_VS == MODE.v_pol);
+            wait (VGA_VS != MODE.v_pol);
+            repeat (20) @(posedge clk);
+
+            // Turn counter-clockwise (KEY[1]) then clockwise (KEY[0]), so
+            // the snake zig-zags away from the border
+            foreach (TURN_FRAMES[i]) begin
+                if (frame == TURN_FRAMES[i]) begin
+                    @(negedge clk) KEY = (i % 2 == 0) ? 2'b10 : 2'b01; // Pulse for one clock
+                    @(negedge clk) KEY = 2'b00;
+                    turns++;
+                end
+            end
+        end
+
+        // Report turn latency (sum/count in the stats block give the exact mean)
+        $display("Turn latency (cycles): min=%0d max=%0d avg=%0d samples=%0d mean=%0d dropped=%0d",
+                 turn_lat_min, turn_lat_max, turn_lat_avg, dut.control_inst.turn_lat_inst.count,
+                 (dut.control_inst.turn_lat_inst.count != 0) ? dut.control_inst.turn_lat_inst.sum / dut.control_inst.turn_lat_inst.count : 0,
+                 turns_dropped);
+        uart.dump();
+
+        if (dut.control_inst.turn_lat_inst.count != turns) begin
+            errors++;
+            $display("%0d latency samples for %0d turns", dut.control_inst.turn_lat_inst.count, turns);
+        end
+        if (turns_dropped != 0) begin
+            errors++;
+            $display("%0d turns dropped", turns_dropped);
+        end
+        if (turn_lat_min == 0 || turn_lat_min > turn_lat_max || turn_lat_max > FRAME_CYCLES) begin
+            errors++;
+            $display("Turn latency outside 1..%0d cycles", FRAME_CYCLES);
+        end
+        if (uart.regs[0] == 0 || uart.regs[1] == 0 || uart.regs[3] == 0) begin
+            errors++;
+            $display("Performance counters missed frames, moves or collision checks");
+        end
+        if (uart.regs[4] == 0 || uart.regs[4] < uart.regs[6]) begin
+            errors++;
+            $display("COMMIT_MAX %0d, COMMIT_LAST %0d", uart.regs[4], uart.regs[6]);
+        end
+        if (errors != 0)
+            $error("snake_game_tb FAILED");
+
         // End simulation
         $finish;
     end
-    
-    // Optional: VGA signal monitoring
+
+    // Optional: frame boundaries in the transcript
     initial begin
-        $monitor("Time=%0t: VGA_HS=%b VGA_VS=%b", $time, VGA_HS, VGA_VS);
+        $monitor("Time=%0t: VGA_VS=%b", $time, VGA_VS);
     end
 
-endmodule
\ No newline at end of file
+endmodule
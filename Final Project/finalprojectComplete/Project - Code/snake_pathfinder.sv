@@ -0,0 +1,182 @@
+// Autopilot pathfinder: breadth-first search over the grid as a bit-vector
+// wavefront, with the occupancy bitmap as the obstacle mask.
+//
+// The search runs backwards, from the apple towards the head, so the answer
+// needs no backtracking: the first of the head's neighbours the wavefront
+// reaches lies on a shortest path, and the snake steps onto it.
+//
+//   S_SEED  - clear the reached set down to the apple cell
+//   S_PASS  - one BFS level: one row per cycle, each row growing into its
+//             free cells from its own and its neighbouring rows' reached
+//             cells as they stood before the pass
+//   S_CHECK - stop if a head neighbour was reached, or if the pass reached
+//             nothing new (no path: fall back to any free neighbour)
+//
+// A level costs GRID_HEIGHT + 1 cycles, so even a path through every cell
+// of the 32x24 grid resolves in under 20k cycles (0.4 ms at 50 MHz), far
+// inside one move at GAME_SPEED_MIN. A start while busy restarts the
+// search. The grid is not wrapped at its edges and the tail cell counts as
+// an obstacle, so the autopilot never relies on either.
+module snake_pathfinder
+    import snake_pkg::*;
+#(
+    parameter GRID_WIDTH = 32,
+    parameter GRID_HEIGHT = 24,
+    parameter BORDER_SIZE = 1
+)(
+    input  logic clk,
+    input  logic reset_n,
+    input  logic start,                              // Snake or apple moved; head/apple valid next cycle
+    input  logic border_visible,                     // Border cells are obstacles
+    input  logic [$clog2(GRID_WIDTH)-1:0] head_x,
+    input  logic [$clog2(GRID_HEIGHT)-1:0] head_y,
+    input  logic [$clog2(GRID_WIDTH)-1:0] apple_x,
+    input  logic [$clog2(GRID_HEIGHT)-1:0] apple_y,
+
+    // Occupancy bitmap row read port (combinational)
+    output logic [$clog2(GRID_HEIGHT)-1:0] row_addr,
+    input  logic [GRID_WIDTH-1:0] row_occupied,
+
+    output logic busy,
+    output logic valid,                              // dir holds the answer for the current head
+    output direction_t dir
+);
+
+    localparam X_BITS = $clog2(GRID_WIDTH);
+    localparam Y_BITS = $clog2(GRID_HEIGHT);
+    localparam logic [X_BITS-1:0] X_LAST = X_BITS'(GRID_WIDTH - 1);
+    localparam logic [Y_BITS-1:0] Y_LAST = Y_BITS'(GRID_HEIGHT - 1);
+
+    // Columns inside the border
+    localparam logic [GRID_WIDTH-1:0] COL_MASK =
+        ({GRID_WIDTH{1'b1}} << BORDER_SIZE) & ({GRID_WIDTH{1'b1}} >> BORDER_SIZE);
+
+    typedef enum logic [1:0] {
+        S_IDLE,
+        S_SEED,
+        S_PASS,
+        S_CHECK
+    } path_state_t;
+
+    path_state_t state;
+    logic [GRID_WIDTH-1:0] reach [0:GRID_HEIGHT-1];  // Cells with a path to the apple
+    logic [GRID_WIDTH-1:0] row_above;                // Row above as it stood before this pass
+    logic [Y_BITS-1:0] row;
+    logic changed;                                   // This pass reached a new cell
+    logic [3:0] nb_free;                             // Head neighbours free: {up, left, down, right}
+
+    assign row_addr = row;
+    assign busy = (state != S_IDLE);
+
+    // Free cells of the row on the read port
+    logic [GRID_WIDTH-1:0] row_free;
+    always_comb begin
+        row_free = ~row_occupied;
+        if (border_visible) begin
+            if ({1'b0, row} < (Y_BITS+1)'(BORDER_SIZE) ||
+                {1'b0, row} >= (Y_BITS+1)'(GRID_HEIGHT - BORDER_SIZE))
+                row_free = '0;
+            else
+                row_free = row_free & COL_MASK;
+        end
+    end
+
+    // One row of one BFS level
+    logic [GRID_WIDTH-1:0] row_below;
+    logic [GRID_WIDTH-1:0] row_next;
+    always_comb begin
+        row_below = (row == Y_LAST) ? '0 : reach[row + 1'b1];
+        row_next = reach[row] |
+                   ((reach[row] << 1 | reach[row] >> 1 | row_above | row_below) & row_free);
+    end
+
+    // Head neighbours the wavefront has reached: {up, left, down, right}
+    logic [3:0] nb_reached;
+    always_comb begin
+        nb_reached[0] = (head_x != X_LAST) && reach[head_y][head_x + 1'b1];
+        nb_reached[1] = (head_y != Y_LAST) && reach[head_y + 1'b1][head_x];
+        nb_reached[2] = (head_x != 0)      && reach[head_y][head_x - 1'b1];
+        nb_reached[3] = (head_y != 0)      && reach[head_y - 1'b1][head_x];
+    end
+
+    function automatic direction_t pick(input logic [3:0] nb);
+        if (nb[0])      pick = DIR_RIGHT;
+        else if (nb[1]) pick = DIR_DOWN;
+        else if (nb[2]) pick = DIR_LEFT;
+        else            pick = DIR_UP;
+    endfunction
+
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n) begin
+            state <= S_IDLE;
+            for (int r = 0; r < GRID_HEIGHT; r++)
+                reach[r] <= '0;
+            row_above <= '0;
+            row <= 0;
+            changed <= 0;
+            nb_free <= 0;
+            valid <= 0;
+            dir <= DIR_RIGHT;
+        end else begin
+            if (start) begin
+                valid <= 0;
+                state <= S_SEED;
+            end else begin
+                case (state)
+                    S_IDLE: ;
+
+                    S_SEED: begin
+                        for (int r = 0; r < GRID_HEIGHT; r++)
+                            reach[r] <= '0;
+                        reach[apple_y][apple_x] <= 1'b1;
+                        row_above <= '0;
+                        row <= 0;
+                        changed <= 0;
+                        nb_free <= 0;
+                        state <= S_PASS;
+                    end
+
+                    S_PASS: begin
+                        reach[row] <= row_next;
+                        row_above <= reach[row];
+                        if (row_next != reach[row])
+                            changed <= 1;
+
+                        // Note which head neighbours are free for the fallback
+                        if (row == head_y) begin
+                            if (head_x != X_LAST) nb_free[0] <= row_free[head_x + 1'b1];
+                            if (head_x != 0)      nb_free[2] <= row_free[head_x - 1'b1];
+                        end
+                        if (head_y != Y_LAST && row == head_y + 1'b1)
+                            nb_free[1] <= row_free[head_x];
+                        if (head_y != 0 && row == head_y - 1'b1)
+                            nb_free[3] <= row_free[head_x];
+
+                        if (row == Y_LAST)
+                            state <= S_CHECK;
+                        else
+                            row <= row + 1'b1;
+                    end
+
+                    S_CHECK: begin
+                        if (nb_reached != 0 || !changed) begin
+                            // Shortest path if there is one, else any free
+                            // neighbour (else carry on and lose)
+                            dir <= pick((nb_reached != 0) ? nb_reached : nb_free);
+                            valid <= (nb_reached != 0) || (nb_free != 0);
+                            state <= S_IDLE;
+                        end else begin
+                            row_above <= '0;
+                            row <= 0;
+                            changed <= 0;
+                            state <= S_PASS;
+                        end
+                    end
+
+                    default: state <= S_IDLE;
+                endcase
+            end
+        end
+    end
+
+endmodule
@@ -0,0 +1,89 @@
+// Types shared between the snake game engine and its renderer
+package snake_pkg;
+
+    // Direction definitions
+    typedef enum logic [1:0] {
+        DIR_RIGHT = 2'b00,
+        DIR_DOWN  = 2'b01,
+        DIR_LEFT  = 2'b10,
+        DIR_UP    = 2'b11
+    } direction_t;
+
+    // Cell kinds
+    typedef enum logic [2:0] {
+        TILE_EMPTY  = 3'd0,
+        TILE_HEAD   = 3'd1,
+        TILE_BODY   = 3'd2,
+        TILE_APPLE  = 3'd3,
+        TILE_BORDER = 3'd4,
+        TILE_TAIL   = 3'd5
+    } tile_t;
+
+    // Cell codes stored in the tile map, one per grid cell. Snake cells
+    // carry the directions of the moves into and out of them, which pick
+    // the sprite's orientation: the head uses dir_in, the tail dir_out, and
+    // the body both (straight or a corner). Other cells leave them at 0.
+    typedef struct packed {
+        tile_t      kind;
+        direction_t dir_in;
+        direction_t dir_out;
+    } cell_t;
+
+    localparam cell_t CELL_EMPTY  = '{TILE_EMPTY, DIR_RIGHT, DIR_RIGHT};
+    localparam cell_t CELL_APPLE  = '{TILE_APPLE, DIR_RIGHT, DIR_RIGHT};
+    localparam cell_t CELL_BORDER = '{TILE_BORDER, DIR_RIGHT, DIR_RIGHT};
+
+    // Sprites in the renderer's sprite ROM. Heads and tails come in four
+    // orientations (SPR_HEAD + direction), corners in four
+    // (SPR_CORNER + {joins right, joins down}).
+    localparam SPR_EMPTY   = 0;
+    localparam SPR_BORDER  = 1;
+    localparam SPR_APPLE   = 2;
+    localparam SPR_HEAD    = 3;                      // Facing dir_in
+    localparam SPR_TAIL    = 7;                      // Leading off towards dir_out
+    localparam SPR_BODY_H  = 11;
+    localparam SPR_BODY_V  = 12;
+    localparam SPR_CORNER  = 13;
+    localparam NUM_SPRITES = 17;
+
+    // Video modes, selected at elaboration time with snake_game's VIDEO_MODE
+    typedef enum int {
+        VIDEO_640X480,                               // 25 MHz pixel clock
+        VIDEO_800X600,                               // 40 MHz pixel clock
+        VIDEO_1024X768,                              // 65 MHz pixel clock
+        VIDEO_1280X720                               // 74.25 MHz pixel clock (74.24 MHz from the PLL)
+    } video_mode_sel_t;
+
+    // Timing, PLL ratio (from the 50 MHz board clock) and cell size of one
+    // video mode. The cell size is picked so every mode keeps a 32-cell wide
+    // grid, which fixes the tile map and body RAM address widths. 74.25 MHz
+    // is not reachable from 50 MHz within the MAX10 PLL's PFD and VCO
+    // limits, so 720p runs at 50 * 49 / 33 = 74.24 MHz, well inside what
+    // monitors accept.
+    typedef struct packed {
+        logic [11:0] h_pixels;
+        logic [11:0] h_fp;
+        logic [11:0] h_pulse;
+        logic [11:0] h_bp;
+        logic        h_pol;
+        logic [11:0] v_pixels;
+        logic [11:0] v_fp;
+        logic [11:0] v_pulse;
+        logic [11:0] v_bp;
+        logic        v_pol;
+        logic [9:0]  pll_mul;                        // pixel_clk = 50 MHz * pll_mul / pll_div
+        logic [9:0]  pll_div;
+        logic [7:0]  cell_size;                      // Grid cell size in pixels
+    } video_mode_t;
+
+    function automatic video_mode_t video_mode(input video_mode_sel_t sel);
+        case (sel)
+            //                          h_pix  fp   pulse bp  pol    v_pix fp  pulse bp  pol    mul  div  cell
+            VIDEO_800X600:  video_mode = '{800,  40,  128, 88,  1'b1, 600,  1,  4,  23, 1'b1,  4,   5,   25};
+            VIDEO_1024X768: video_mode = '{1024, 24,  136, 160, 1'b0, 768,  3,  6,  29, 1'b0,  13,  10,  32};
+            VIDEO_1280X720: video_mode = '{1280, 110, 40,  220, 1'b1, 720,  5,  5,  20, 1'b1,  49,  33,  40};
+            default:        video_mode = '{640,  16,  96,  48,  1'b0, 480,  10, 2,  33, 1'b0,  1,   2,   20};
+        endcase
+    endfunction
+
+endpackage
@@ -0,0 +1,296 @@
+// Pipelined pixel renderer for the snake game.
+//
+// Grid position is tracked with incremental counters driven by the VGA
+// controller's display enable, so no pixel coordinate is ever divided by
+// GRID_SIZE. Each cell is drawn from a sprite (see sprite_rom) picked by
+// its cell code, and each pixel passes through three register stages:
+//   stage 1 - sprite pixel (shifted out of the cell's sprite row)
+//   stage 2 - palette lookup
+//   stage 3 - VGA output register
+// The sprite row is fetched ahead, while the previous cell is being drawn:
+// the tile map is read one cell ahead of the counters, the cell code is
+// turned into a sprite number, the sprite ROM is read, and the row is
+// loaded into the stage 1 shift register on the cell's first pixel. The
+// first cell of a line is fetched the same way during horizontal blanking.
+// So textured cells cost the same three stages a flat fill did. The sync
+// signals are delayed by the same three stages so they stay aligned with
+// the colour data. No stage holds more than a counter compare, a 2-way
+// shift/load mux or a 16-entry palette, which keeps the larger modes'
+// 65 MHz and 74.25 MHz pixel clocks within reach on the MAX10.
+//
+// A text layer (see text_overlay) runs alongside stages 1 and 2 and is
+// merged in at stage 3: glyph pixels in COLOR_TEXT over a black character
+// cell, everything else from the palette.
+module snake_renderer
+    import snake_pkg::*;
+#(
+    parameter GRID_SIZE = 20,
+    parameter GRID_WIDTH = 32,
+    parameter GRID_HEIGHT = 24,
+    parameter H_POL = 1'b0,                          // Horizontal sync polarity of the VGA controller
+    parameter V_POL = 1'b0,                          // Vertical sync polarity of the VGA controller
+    parameter [11:0] COLOR_BLACK = 12'h000,
+    parameter [11:0] COLOR_GREEN = 12'h0F0,
+    parameter [11:0] COLOR_RED = 12'hF00,
+    parameter [11:0] COLOR_BLUE = 12'h00F,
+    parameter [11:0] COLOR_DARK_GREEN = 12'h080,
+    parameter [11:0] COLOR_DARK_BLUE = 12'h008,      // Border mortar
+    parameter [11:0] COLOR_DARK_RED = 12'h800,       // Apple shade
+    parameter [11:0] COLOR_WHITE = 12'hFFF,          // Eyes
+    parameter [11:0] COLOR_TEXT = 12'hFF0,
+    parameter CHAR_SCALE = 2                         // Screen pixels per font pixel of the text layer
+)(
+    input  logic pixel_clk,
+    input  logic reset_n,
+
+    // Raw timing from the VGA controller
+    input  logic disp_ena,
+    input  logic h_sync,
+    input  logic v_sync,
+
+    // Tile map read port ({y, x} address, data one clock later). The
+    // address runs one cell ahead of the pixel being drawn.
+    output logic [$clog2(GRID_WIDTH)+$clog2(GRID_HEIGHT)-1:0] tile_addr,
+    input  logic [$bits(cell_t)-1:0] tile_code,
+
+    // Text layer character RAM write port (see text_writer)
+    input  logic char_wr_clk,
+    input  logic char_wr_en,
+    input  logic [10:0] char_wr_addr,
+    input  logic [6:0] char_wr_data,
+
+    // Pipelined VGA outputs
+    output logic [3:0] VGA_R,
+    output logic [3:0] VGA_G,
+    output logic [3:0] VGA_B,
+    output logic VGA_HS,
+    output logic VGA_VS
+);
+
+    localparam X_BITS = $clog2(GRID_WIDTH);
+    localparam Y_BITS = $clog2(GRID_HEIGHT);
+    localparam CELL_BITS = $clog2(GRID_SIZE);
+    localparam logic [CELL_BITS-1:0] CELL_LAST = CELL_BITS'(GRID_SIZE - 1);
+
+    //-------------------------------------------------------------------------
+    // Stage 0: grid position counters. The X counters run while disp_ena is
+    // high and clear in horizontal blanking; the Y counters step at the end
+    // of every visible line and clear during the vertical sync pulse.
+    //-------------------------------------------------------------------------
+    logic [X_BITS-1:0] grid_x;
+    logic [Y_BITS-1:0] grid_y;
+    logic [CELL_BITS-1:0] cell_px;                   // Pixel offset within the cell (X)
+    logic [CELL_BITS-1:0] cell_py;                   // Pixel offset within the cell (Y)
+    logic disp_ena_d;
+
+    always_ff @(posedge pixel_clk or negedge reset_n) begin
+        if (~reset_n) begin
+            grid_x <= 0;
+            grid_y <= 0;
+            cell_px <= 0;
+            cell_py <= 0;
+            disp_ena_d <= 1'b0;
+        end else begin
+            disp_ena_d <= disp_ena;
+
+            if (disp_ena) begin
+                if (cell_px == CELL_LAST) begin
+                    cell_px <= 0;
+                    grid_x <= grid_x + 1'b1;
+                end else begin
+                    cell_px <= cell_px + 1'b1;
+                end
+            end else begin
+                cell_px <= 0;
+                grid_x <= 0;
+            end
+
+            if (v_sync == V_POL) begin
+                cell_py <= 0;
+                grid_y <= 0;
+            end else if (disp_ena_d && !disp_ena) begin
+                if (cell_py == CELL_LAST) begin
+                    cell_py <= 0;
+                    grid_y <= grid_y + 1'b1;
+                end else begin
+                    cell_py <= cell_py + 1'b1;
+                end
+            end
+        end
+    end
+
+    //-------------------------------------------------------------------------
+    // Sprite row prefetch. The tile map is read for the next cell (cell 0
+    // while display enable is low), its code is registered as a sprite
+    // number, and the ROM row for that sprite and cell_py follows a clock
+    // later. All three hold still for the rest of the cell, so the row is
+    // ready well before the cell's first pixel.
+    //-------------------------------------------------------------------------
+    localparam SPRITE_BITS = $clog2(NUM_SPRITES);
+
+    logic [SPRITE_BITS-1:0] next_sprite;
+    logic [1:0] next_bank;                           // Palette bank of next_sprite
+    logic [2*GRID_SIZE-1:0] rom_row;
+    logic [1:0] rom_bank;
+
+    assign tile_addr = {grid_y, disp_ena ? grid_x + 1'b1 : X_BITS'(0)};
+
+    // Sprite and palette bank for a cell code
+    function automatic logic [SPRITE_BITS+1:0] cell_sprite(input cell_t cell);
+        direction_t from;
+        logic right, down;
+        case (cell.kind)
+            TILE_BORDER: return {SPRITE_BITS'(SPR_BORDER), 2'd0};
+            TILE_APPLE:  return {SPRITE_BITS'(SPR_APPLE), 2'd2};
+            TILE_HEAD:   return {SPRITE_BITS'(SPR_HEAD) + SPRITE_BITS'(cell.dir_in), 2'd1};
+            TILE_TAIL:   return {SPRITE_BITS'(SPR_TAIL) + SPRITE_BITS'(cell.dir_out), 2'd1};
+            TILE_BODY: begin
+                if (cell.dir_in == cell.dir_out)
+                    return {SPRITE_BITS'(cell.dir_in[0] ? SPR_BODY_V : SPR_BODY_H), 2'd1};
+                // A corner joins the side the snake came in from and the side
+                // it left by; one of them is left/right, the other up/down
+                from = direction_t'(cell.dir_in ^ 2'b10);
+                right = from == DIR_RIGHT || cell.dir_out == DIR_RIGHT;
+                down = from == DIR_DOWN || cell.dir_out == DIR_DOWN;
+                return {SPRITE_BITS'(SPR_CORNER) + SPRITE_BITS'({right, down}), 2'd1};
+            end
+            default:     return {SPRITE_BITS'(SPR_EMPTY), 2'd0};
+        endcase
+    endfunction
+
+    always_ff @(posedge pixel_clk or negedge reset_n) begin
+        if (~reset_n) begin
+            next_sprite <= SPRITE_BITS'(SPR_EMPTY);
+            next_bank <= 2'd0;
+            rom_bank <= 2'd0;
+        end else begin
+            {next_sprite, next_bank} <= cell_sprite(cell_t'(tile_code));
+            rom_bank <= next_bank;
+        end
+    end
+
+    sprite_rom #(
+        .GRID_SIZE(GRID_SIZE)
+    ) sprite_inst (
+        .clk(pixel_clk),
+        .addr({next_sprite, cell_py}),
+        .row(rom_row)
+    );
+
+    //-------------------------------------------------------------------------
+    // Stage 1: sprite pixel. The prefetched row is loaded on a cell's first
+    // pixel (and throughout blanking) and shifted one pixel per clock.
+    //-------------------------------------------------------------------------
+    logic [2*GRID_SIZE-1:0] s1_row;                  // s1_row[1:0] is this pixel
+    logic [1:0] s1_bank;
+    logic s1_de, s1_hs, s1_vs;
+
+    always_ff @(posedge pixel_clk or negedge reset_n) begin
+        if (~reset_n) begin
+            s1_row <= '0;
+            s1_bank <= 2'd0;
+            s1_de <= 1'b0;
+            s1_hs <= ~H_POL;
+            s1_vs <= ~V_POL;
+        end else begin
+            if (!disp_ena || cell_px == 0) begin
+                s1_row <= rom_row;
+                s1_bank <= rom_bank;
+            end else begin
+                s1_row <= s1_row >> 2;
+            end
+            s1_de <= disp_ena;
+            s1_hs <= h_sync;
+            s1_vs <= v_sync;
+        end
+    end
+
+    //-------------------------------------------------------------------------
+    // Stage 2: palette lookup, a 4-color bank per kind of sprite
+    //-------------------------------------------------------------------------
+    logic [11:0] s2_color;
+    logic s2_de, s2_hs, s2_vs;
+
+    always_ff @(posedge pixel_clk or negedge reset_n) begin
+        if (~reset_n) begin
+            s2_color <= COLOR_BLACK;
+            s2_de <= 1'b0;
+            s2_hs <= ~H_POL;
+            s2_vs <= ~V_POL;
+        end else begin
+            case ({s1_bank, s1_row[1:0]})
+                4'b00_01: s2_color <= COLOR_BLUE;        // Border brick
+                4'b00_10: s2_color <= COLOR_DARK_BLUE;   // Border mortar
+                4'b01_01: s2_color <= COLOR_GREEN;       // Head
+                4'b01_10: s2_color <= COLOR_DARK_GREEN;  // Body and tail
+                4'b01_11: s2_color <= COLOR_WHITE;       // Eyes
+                4'b10_01: s2_color <= COLOR_RED;         // Apple
+                4'b10_10: s2_color <= COLOR_DARK_RED;    // Apple shade
+                4'b10_11: s2_color <= COLOR_DARK_GREEN;  // Leaf
+                default:  s2_color <= COLOR_BLACK;
+            endcase
+            s2_de <= s1_de;
+            s2_hs <= s1_hs;
+            s2_vs <= s1_vs;
+        end
+    end
+
+    //-------------------------------------------------------------------------
+    // Text layer, aligned with stage 2
+    //-------------------------------------------------------------------------
+    logic text_pixel, text_box;
+
+    text_overlay #(
+        .CHAR_SCALE(CHAR_SCALE),
+        .V_POL(V_POL)
+    ) text_inst (
+        .pixel_clk(pixel_clk),
+        .reset_n(reset_n),
+        .disp_ena(disp_ena),
+        .v_sync(v_sync),
+        .wr_clk(char_wr_clk),
+        .wr_en(char_wr_en),
+        .wr_addr(char_wr_addr),
+        .wr_data(char_wr_data),
+        .text_pixel(text_pixel),
+        .text_box(text_box)
+    );
+
+    //-------------------------------------------------------------------------
+    // Stage 3: text merge and VGA output registers. de_out marks the
+    // visible pixels for simulation (the Verilator frame grabber reads it,
+    // see sim/snake.vlt); the board has no pin for it.
+    //-------------------------------------------------------------------------
+    logic de_out;
+    logic [11:0] out_color;
+
+    always_comb begin
+        if (!s2_de)
+            out_color = COLOR_BLACK;
+        else if (text_pixel)
+            out_color = COLOR_TEXT;
+        else if (text_box)
+            out_color = COLOR_BLACK;
+        else
+            out_color = s2_color;
+    end
+
+    always_ff @(posedge pixel_clk or negedge reset_n) begin
+        if (~reset_n) begin
+            de_out <= 1'b0;
+            VGA_R <= 4'h0;
+            VGA_G <= 4'h0;
+            VGA_B <= 4'h0;
+            VGA_HS <= ~H_POL;
+            VGA_VS <= ~V_POL;
+        end else begin
+            de_out <= s2_de;
+            VGA_R <= out_color[11:8];
+            VGA_G <= out_color[7:4];
+            VGA_B <= out_color[3:0];
+            VGA_HS <= s2_hs;
+            VGA_VS <= s2_vs;
+        end
+    end
+
+endmodule
@@ -0,0 +1,170 @@
+// Replays a per-frame input trace (sim/snake_trace.h) into DE10_Lite_Snake.
+//
+// Run with +trace=<file>. Frame f's KEY/SW values are applied from the first
+// clock after the f-th active edge of VGA_VS, with SW held at 0 for the
+// first RESET_CYCLES clocks. The Verilator driver (sim/sim_main.cpp
+// --replay) follows the same rules, so both play the same game.
+// LFSR_SEED must match the seed stored in the trace, and SIM_SPEEDUP the
+// one it was recorded with.
+module snake_trace_tb #(
+    parameter snake_pkg::video_mode_sel_t VIDEO_MODE = snake_pkg::VIDEO_640X480,
+    parameter [15:0] LFSR_SEED = 16'hACE1,
+    parameter RESET_CYCLES = 100,
+    parameter SIM_SPEEDUP = 1                        // See DE10_Lite_Snake
+)();
+    // Testbench signals
+    logic clk;
+    logic [1:0] KEY;
+    logic [9:0] SW;
+    logic [9:0] LEDR;
+    logic [7:0] HEX0, HEX1, HEX2, HEX3, HEX4, HEX5;
+    logic [3:0] VGA_R;
+    logic [3:0] VGA_G;
+    logic [3:0] VGA_B;
+    logic VGA_HS;
+    logic VGA_VS;
+
+    localparam V_POL = snake_pkg::video_mode(VIDEO_MODE).v_pol;
+
+    // Instantiate the board top level
+    DE10_Lite_Snake #(
+        .VIDEO_MODE(VIDEO_MODE),
+        .LFSR_SEED(LFSR_SEED),
+        .SIM_SPEEDUP(SIM_SPEEDUP)
+    ) dut (
+        .ADC_CLK_10(1'b0),
+        .MAX10_CLK1_50(clk),
+        .MAX10_CLK2_50(1'b0),
+        .KEY(KEY),
+        .SW(SW),
+        .LEDR(LEDR),
+        .HEX0(HEX0),
+        .HEX1(HEX1),
+        .HEX2(HEX2),
+        .HEX3(HEX3),
+        .HEX4(HEX4),
+        .HEX5(HEX5),
+        .VGA_R(VGA_R),
+        .VGA_G(VGA_G),
+        .VGA_B(VGA_B),
+        .VGA_HS(VGA_HS),
+        .VGA_VS(VGA_VS)
+    );
+
+    // Clock generation
+    initial begin
+        clk = 0;
+        forever #10 clk = ~clk; // 50MHz clock
+    end
+
+    // Trace reader state
+    integer fd;
+    int unsigned num_frames;
+    int unsigned frame;
+    longint unsigned run_left;
+    logic [1:0] run_key;
+    logic [9:0] run_sw;
+
+    function automatic int get_byte();
+        int c;
+        c = $fgetc(fd);
+        if (c < 0)
+            $fatal(1, "trace ends early");
+        return c;
+    endfunction
+
+    // Load the next record when the current run is used up
+    task automatic next_frame(output logic [1:0] key, output logic [9:0] sw);
+        int token;
+        longint unsigned extra;
+        int b, shift;
+
+        if (run_left == 0) begin
+            token = get_byte();
+            run_key = token[7:6];
+            if (token[5]) begin
+                b = get_byte();
+                run_sw = {2'(get_byte()), 8'(b)};
+            end
+            extra = 0;
+            shift = 0;
+            if (token[4]) begin
+                do begin
+                    b = get_byte();
+                    extra = extra | (longint'(b & 8'h7F) << shift);
+                    shift += 7;
+                end while (b & 8'h80);
+            end
+            run_left = (extra << 4) + token[3:0] + 1;
+        end
+        run_left--;
+        key = run_key;
+        sw = run_sw;
+    endtask
+
+    // Test sequence
+    initial begin
+        string path;
+        int b0, b1, b2, b3;
+        logic [15:0] seed;
+        logic [1:0] key_next;
+        logic [9:0] sw_next;
+        logic vs_prev;
+
+        if (!$value$plusargs("trace=%s", path))
+            $fatal(1, "usage: +trace=<file>");
+        fd = $fopen(path, "rb");
+        if (fd == 0)
+            $fatal(1, "cannot open %s", path);
+
+        // Header: "SNKT", version, reserved, seed, frames, initial SW
+        b0 = get_byte(); b1 = get_byte(); b2 = get_byte(); b3 = get_byte();
+        if ({8'(b0), 8'(b1), 8'(b2), 8'(b3)} != "SNKT")
+            $fatal(1, "%s is not a snake trace", path);
+        if (get_byte() != 1)
+            $fatal(1, "unsupported trace version");
+        void'(get_byte());
+        b0 = get_byte(); b1 = get_byte();
+        seed = {8'(b1), 8'(b0)};
+        if (seed != LFSR_SEED)
+            $fatal(1, "trace recorded with LFSR_SEED=%h, testbench has %h", seed, LFSR_SEED);
+        b0 = get_byte(); b1 = get_byte(); b2 = get_byte(); b3 = get_byte();
+        num_frames = {8'(b3), 8'(b2), 8'(b1), 8'(b0)};
+        b0 = get_byte(); b1 = get_byte();
+        run_sw = {2'(b1), 8'(b0)};
+        run_left = 0;
+
+        // Frame 0 inputs, with the game held in reset first
+        frame = 0;
+        next_frame(key_next, sw_next);
+        KEY = key_next;
+        SW = 10'b0;
+        repeat (RESET_CYCLES) @(posedge clk);
+        SW = sw_next;
+
+        // One record per frame, switched at each active edge of VGA_VS.
+        // VGA_VS is looked at just after the clock edge that moved it, so the
+        // new inputs are in place for the following edge.
+        vs_prev = ~V_POL;
+        while (frame + 1 < num_frames) begin
+            @(posedge clk);
+            #1;
+            if (VGA_VS == V_POL && vs_prev != V_POL) begin
+                frame++;
+                next_frame(key_next, sw_next);
+                KEY = key_next;
+                SW = sw_next;
+            end
+            vs_prev = VGA_VS;
+        end
+
+        // Let the last frame finish
+        wait (VGA_VS != V_POL);
+        wait (VGA_VS == V_POL);
+        $display("Replayed %0d frames: score %0d, state %s", num_frames,
+                 dut.grid_mode.snake_inst.score, dut.grid_mode.snake_inst.game_state.name());
+        $fclose(fd);
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,860 @@
+// Snake in a large world held in SDRAM, seen through a viewport that
+// follows the head.
+//
+// The world is WORLD_WIDTH x WORLD_HEIGHT cells (up to 1024 x 1024), one
+// byte per cell holding a cell_t code, two cells to an SDRAM word: cell
+// (x, y) is byte x[0] of word {y, x[..:1]}. A move reads the cell the head
+// moves into (self collision) and rewrites the neck, old tail, head and
+// new tail cells; a new apple goes on a free cell of the viewport, away
+// from its edges, so it is always on screen.
+// The border is not stored: it is the world's edge, tested by coordinates
+// for collisions and drawn over the cells as they are fetched.
+//
+// The screen shows the GRID_WIDTH x GRID_HEIGHT cells from the camera,
+// which keeps the head centred and stops at the world's edges. Each row of
+// cells is fetched just before it is drawn: when the renderer moves on to
+// cell row r, in the horizontal blanking before its first line, the row is
+// read in 2 or 3 bursts of 8 words into one half of a two-row line cache;
+// row 0 is fetched at the end of vertical sync. A fetch waits for at most
+// one engine access (CLEAR_CHUNK words) and a refresh, so it is done in
+// about 80 clk cycles against at least 240 in the shortest horizontal
+// blanking (1024x768), well before the renderer reads the row's first cell
+// a few pixels ahead of the line, and scanout never waits on the SDRAM.
+// The camera is taken at the row 0 fetch, so every row of a frame uses the
+// same one.
+//
+// Moves are taken on the frame tick as in snake_game, while vertical sync
+// is on, and their SDRAM writes are done long before the row 0 fetch. The
+// body ring buffer stays on chip, so the snake stops growing at
+// MAX_SNAKE_LEN. The autopilot needs the whole occupancy bitmap on chip and
+// is not available here; SW[1] is ignored.
+module snake_world
+    import snake_pkg::*;
+#(
+    parameter video_mode_sel_t VIDEO_MODE = VIDEO_640X480, // Video mode, see snake_pkg
+    parameter WORLD_WIDTH = 1024,                    // World size in cells: powers of two, from
+    parameter WORLD_HEIGHT = 1024,                   // the viewport size up to 1024
+    parameter [15:0] LFSR_SEED = 16'hACE1,           // Apple sequence seed
+    parameter SIM_SPEEDUP = 1                        // Simulation only: divides the frames per move
+)(
+    input logic clk,           // 50MHz system clock
+    input logic reset_n,       // Active low reset
+    input logic [1:0] KEY,     // Direction control keys
+    input logic [9:0] SW,      // Switches, SW[0] controls border visibility
+    output logic [3:0] VGA_R,  // VGA Red channel
+    output logic [3:0] VGA_G,  // VGA Green channel
+    output logic [3:0] VGA_B,  // VGA Blue channel
+    output logic VGA_HS,       // Horizontal sync
+    output logic VGA_VS,       // Vertical sync
+    output logic [9:0] score,  // Saturates at 999
+    output logic [31:0] turn_lat_min,  // Key pulse to head move, in clk cycles
+    output logic [31:0] turn_lat_max,
+    output logic [31:0] turn_lat_avg,
+    output logic [7:0] turns_dropped,  // Turns lost to a full turn queue
+
+    // Performance counters (Avalon-MM slave, see perf_counters)
+    input  logic [2:0] perf_address,
+    input  logic perf_read,
+    output logic [31:0] perf_readdata,
+    input  logic perf_write,
+    input  logic [31:0] perf_writedata,
+
+    // SDRAM
+    output logic [12:0] DRAM_ADDR,
+    output logic [1:0]  DRAM_BA,
+    output logic        DRAM_CAS_N,
+    output logic        DRAM_CKE,
+    output logic        DRAM_CLK,
+    output logic        DRAM_CS_N,
+    inout  wire  [15:0] DRAM_DQ,
+    output logic        DRAM_LDQM,
+    output logic        DRAM_RAS_N,
+    output logic        DRAM_UDQM,
+    output logic        DRAM_WE_N
+);
+
+    // Screen size and sync polarity for the selected mode (snake_display
+    // has its timing)
+    localparam video_mode_t MODE = video_mode(VIDEO_MODE);
+    localparam int H_PIXELS = int'(MODE.h_pixels);
+    localparam int V_PIXELS = int'(MODE.v_pixels);
+    localparam logic V_POL = MODE.v_pol;
+
+    // Game parameters
+    localparam int GRID_SIZE = int'(MODE.cell_size); // Size of each grid cell
+    localparam GRID_WIDTH = H_PIXELS / GRID_SIZE;    // Viewport width in cells (32 in every mode)
+    localparam GRID_HEIGHT = V_PIXELS / GRID_SIZE;   // Viewport height in cells (24, or 18 at 720p)
+    parameter BORDER_SIZE = 1;                       // Border thickness in cells, at the world's edge
+    parameter INIT_SNAKE_LEN = 1;                    // Initial snake length
+    parameter GAME_SPEED_MAX = 14;                   // Slowest game speed in frames per move (higher = slower)
+    parameter GAME_SPEED_MIN = 4;                    // Fastest game speed in frames per move (lower = faster)
+    parameter GAME_SPEED_DECREMENT = 1;              // Frames per move removed per apple eaten
+
+    // Frames per move as played, SIM_SPEEDUP times fewer (at least one)
+    localparam SPEED_MAX = (GAME_SPEED_MAX / SIM_SPEEDUP > 1) ? GAME_SPEED_MAX / SIM_SPEEDUP : 1;
+    localparam SPEED_MIN = (GAME_SPEED_MIN / SIM_SPEEDUP > 1) ? GAME_SPEED_MIN / SIM_SPEEDUP : 1;
+    localparam SPEED_BITS = $clog2(GAME_SPEED_MAX) + 1;
+    parameter TURN_QUEUE_DEPTH = 4;                  // Key presses held for upcoming moves
+    parameter MAX_SNAKE_LEN = 4096;                  // Body ring buffer depth (power of two)
+    parameter APPLE_MARGIN = 2;                      // Viewport cells along each edge kept free of apples
+    parameter APPLE_TRIES = 64;                      // Random cells probed before scanning for an apple
+    parameter CLEAR_CHUNK = 32;                      // Words per SDRAM access when clearing the world
+
+    localparam X_BITS = $clog2(GRID_WIDTH);
+    localparam Y_BITS = $clog2(GRID_HEIGHT);
+    localparam WX_BITS = $clog2(WORLD_WIDTH);
+    localparam WY_BITS = $clog2(WORLD_HEIGHT);
+    localparam WORLD_WORDS = WORLD_WIDTH * WORLD_HEIGHT / 2;
+    localparam CLEAR_BITS = $clog2(WORLD_WORDS);
+    localparam BODY_ADDR_BITS = $clog2(MAX_SNAKE_LEN);
+    localparam APPLE_W = GRID_WIDTH - 2 * APPLE_MARGIN;  // Apple window, inside the viewport
+    localparam APPLE_H = GRID_HEIGHT - 2 * APPLE_MARGIN;
+    localparam TRIES_BITS = $clog2(APPLE_TRIES + 1);
+
+    // Engine state
+    typedef enum logic [3:0] {
+        W_CLEAR,                                     // Zero the whole world
+        W_LAYOUT,                                    // Write the initial snake, tail first
+        W_APPLE,                                     // Pick a cell for the apple and read it
+        W_APPLE_SET,                                 // Write the apple there
+        W_RUN,                                       // Wait for the next move
+        W_PROBE,                                     // Read the cell the head moves into
+        W_NECK,                                      // Redraw the old head as body
+        W_TAIL,                                      // Clear the old tail
+        W_HEAD,                                      // Draw the new head
+        W_END,                                       // Redraw the new tail as a tail
+        W_OVER                                       // Game over, restart on the next tick
+    } world_state_t;
+
+    // Pixel clock, its reset and vertical sync, from snake_display
+    logic pixel_clk;
+    logic pixel_reset_n;
+    logic vga_v_sync;
+
+    // Game variables
+    world_state_t w_state;
+    direction_t curr_direction;                      // Direction of the last move
+    direction_t move_dir;                            // Direction of the pending move
+    direction_t neck_dir;                            // Direction of the move before it
+    logic [WX_BITS-1:0] head_x;                      // Head position in the world
+    logic [WY_BITS-1:0] head_y;
+    logic [WX_BITS-1:0] tail_x;                      // Tail position (from body RAM)
+    logic [WY_BITS-1:0] tail_y;
+    logic [WX_BITS-1:0] mv_x;                        // Cell the head is moving into
+    logic [WY_BITS-1:0] mv_y;
+    logic mv_grows;                                  // The move eats the apple
+    logic extend;                                    // The move grows the snake
+    logic [BODY_ADDR_BITS-1:0] head_ptr;             // Ring buffer slot holding the head
+    logic [BODY_ADDR_BITS-1:0] tail_ptr;             // Ring buffer slot holding the tail
+    logic [BODY_ADDR_BITS:0] snake_length;           // Current snake length
+    logic [BODY_ADDR_BITS-1:0] init_idx;             // Segment being laid out
+    logic [WX_BITS-1:0] apple_x;                     // Apple position
+    logic [WY_BITS-1:0] apple_y;
+    logic apple_valid;                               // An apple is in the world
+    logic [WX_BITS-1:0] cand_x;                      // Apple candidate
+    logic [WY_BITS-1:0] cand_y;
+    logic cand_ok;                                   // cand_x/cand_y picked
+    logic [TRIES_BITS-1:0] apple_tries;
+    logic apple_scan;                                // Random tries used up, scanning the window
+    logic [X_BITS-1:0] scan_x;                       // Cell of the window being scanned
+    logic [Y_BITS-1:0] scan_y;
+    logic [CLEAR_BITS-1:0] clear_addr;               // Next word to clear
+    logic [SPEED_BITS-1:0] game_speed;               // Current game speed (frames per move)
+    logic frame_tick;                                // Pulses once per frame, in vertical blanking
+    logic game_tick;                                 // Pulses when snake should move
+    logic running;                                   // A game is in progress
+    logic border_visible;                            // Border visibility flag
+
+    // LFSR for random number generation
+    logic [15:0] lfsr;
+
+    //-------------------------------------------------------------------------
+    // SDRAM: one controller shared by the line fetcher and the game engine.
+    // The fetcher always goes first.
+    //-------------------------------------------------------------------------
+    logic sd_ready, sd_req, sd_we, sd_ack, sd_wnext, sd_rvalid;
+    logic [24:0] sd_addr;
+    logic [10:0] sd_len;
+    logic [15:0] sd_wdata, sd_rdata;
+    logic [1:0] sd_wbe;
+
+    sdram_ctrl sdram_inst (
+        .clk(clk),
+        .reset_n(reset_n),
+        .ready(sd_ready),
+        .req(sd_req),
+        .we(sd_we),
+        .addr(sd_addr),
+        .len(sd_len),
+        .ack(sd_ack),
+        .wdata(sd_wdata),
+        .wbe(sd_wbe),
+        .wnext(sd_wnext),
+        .rdata(sd_rdata),
+        .rvalid(sd_rvalid),
+        .DRAM_ADDR(DRAM_ADDR),
+        .DRAM_BA(DRAM_BA),
+        .DRAM_CAS_N(DRAM_CAS_N),
+        .DRAM_CKE(DRAM_CKE),
+        .DRAM_CLK(DRAM_CLK),
+        .DRAM_CS_N(DRAM_CS_N),
+        .DRAM_DQ(DRAM_DQ),
+        .DRAM_LDQM(DRAM_LDQM),
+        .DRAM_RAS_N(DRAM_RAS_N),
+        .DRAM_UDQM(DRAM_UDQM),
+        .DRAM_WE_N(DRAM_WE_N)
+    );
+
+    function automatic logic [24:0] cell_word(input logic [WX_BITS-1:0] x,
+                                              input logic [WY_BITS-1:0] y);
+        return 25'({y, x[WX_BITS-1:1]});
+    endfunction
+
+    function automatic logic is_border_cell(input logic [WX_BITS-1:0] x,
+                                            input logic [WY_BITS-1:0] y);
+        return int'(x) < BORDER_SIZE || int'(x) >= WORLD_WIDTH - BORDER_SIZE ||
+               int'(y) < BORDER_SIZE || int'(y) >= WORLD_HEIGHT - BORDER_SIZE;
+    endfunction
+
+    logic fetch_req, fetch_ack, fetch_rvalid;
+    logic [24:0] fetch_addr;
+    logic [10:0] fetch_len;
+    logic eng_req, eng_ack, eng_rvalid, eng_done;
+    logic op_valid, op_we;
+    logic [WX_BITS-1:0] op_x;
+    logic [WY_BITS-1:0] op_y;
+    cell_t op_code, rd_code;
+    logic [10:0] op_len;
+    logic eng_active;                                // Engine access taken, not yet done
+    logic [10:0] eng_left;                           // Write words still to go out
+    logic rd_to_fetch;                               // Read data belongs to the fetcher
+    logic [1:0] tail_dir;                            // Direction of the move out of the tail
+    logic end_settled;                               // tail_x/tail_y/tail_dir valid in W_END
+
+    assign sd_req = fetch_req || eng_req;
+    assign sd_we = fetch_req ? 1'b0 : op_we;
+    assign sd_addr = fetch_req ? fetch_addr : (w_state == W_CLEAR) ? 25'(clear_addr) : cell_word(op_x, op_y);
+    assign sd_len = fetch_req ? fetch_len : op_len;
+    assign sd_wdata = {1'b0, op_code, 1'b0, op_code};
+    assign sd_wbe = (w_state == W_CLEAR) ? 2'b11 : (op_x[0] ? 2'b10 : 2'b01);
+    assign fetch_ack = sd_ack && fetch_req;
+    assign eng_ack = sd_ack && !fetch_req;
+    assign fetch_rvalid = sd_rvalid && rd_to_fetch;
+    assign eng_rvalid = sd_rvalid && !rd_to_fetch;
+
+    // Engine access for the current state: one cell read or write (a run of
+    // zero words while clearing). The request is held until taken, and the
+    // state only moves on once the access is done, so the operands stay put.
+    always_comb begin
+        op_valid = 1'b1;
+        op_we = 1'b1;
+        op_x = head_x;
+        op_y = head_y;
+        op_code = CELL_EMPTY;
+        op_len = 11'd1;
+        case (w_state)
+            W_CLEAR: begin
+                op_len = 11'(CLEAR_CHUNK);
+            end
+            W_LAYOUT: begin
+                op_x = WX_BITS'(WORLD_WIDTH / 2 - INIT_SNAKE_LEN + 1 + int'(init_idx));
+                op_y = WY_BITS'(WORLD_HEIGHT / 2);
+                if (init_idx == BODY_ADDR_BITS'(INIT_SNAKE_LEN - 1))
+                    op_code = '{TILE_HEAD, curr_direction, curr_direction};
+                else if (init_idx == 0)
+                    op_code = '{TILE_TAIL, DIR_RIGHT, DIR_RIGHT};
+                else
+                    op_code = '{TILE_BODY, DIR_RIGHT, DIR_RIGHT};
+            end
+            W_APPLE: begin
+                op_valid = cand_ok && !is_border_cell(cand_x, cand_y);
+                op_we = 1'b0;
+                op_x = cand_x;
+                op_y = cand_y;
+            end
+            W_APPLE_SET: begin
+                op_x = cand_x;
+                op_y = cand_y;
+                op_code = CELL_APPLE;
+            end
+            W_PROBE: begin
+                op_we = 1'b0;
+                op_x = mv_x;
+                op_y = mv_y;
+            end
+            W_NECK: begin
+                op_code = '{TILE_BODY, neck_dir, curr_direction};
+            end
+            W_TAIL: begin
+                op_x = tail_x;
+                op_y = tail_y;
+            end
+            W_HEAD: begin
+                op_x = mv_x;
+                op_y = mv_y;
+                op_code = '{TILE_HEAD, curr_direction, curr_direction};
+            end
+            W_END: begin
+                op_valid = end_settled;
+                op_x = tail_x;
+                op_y = tail_y;
+                op_code = '{TILE_TAIL, direction_t'(tail_dir), direction_t'(tail_dir)};
+            end
+            default: begin
+                op_valid = 1'b0;
+            end
+        endcase
+
+        rd_code = cell_t'(op_x[0] ? sd_rdata[14:8] : sd_rdata[6:0]);
+    end
+
+    assign eng_req = op_valid && !eng_active;
+    assign eng_done = eng_active && (op_we ? (sd_wnext && eng_left == 1) : eng_rvalid);
+
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n) begin
+            eng_active <= 0;
+            eng_left <= 0;
+            rd_to_fetch <= 0;
+        end else begin
+            if (sd_ack)
+                rd_to_fetch <= fetch_req;
+            if (eng_ack) begin
+                eng_active <= 1;
+                eng_left <= op_len;
+            end else begin
+                if (sd_wnext)
+                    eng_left <= eng_left - 1'b1;
+                if (eng_done)
+                    eng_active <= 0;
+            end
+        end
+    end
+
+    //-------------------------------------------------------------------------
+    // Snake body ring buffer (M9K), as in snake_game: the read port follows
+    // tail_ptr so the tail cell is always on hand.
+    //-------------------------------------------------------------------------
+    logic body_wr_en;
+    logic [BODY_ADDR_BITS-1:0] body_wr_addr;
+
+    assign body_wr_en = eng_done && (w_state == W_LAYOUT || w_state == W_HEAD);
+    assign body_wr_addr = (w_state == W_LAYOUT) ? init_idx : head_ptr + 1'b1;
+
+    dual_port_ram #(
+        .DATA_WIDTH(WX_BITS + WY_BITS),
+        .ADDR_WIDTH(BODY_ADDR_BITS)
+    ) body_ram (
+        .wr_clk(clk),
+        .wr_en(body_wr_en),
+        .wr_addr(body_wr_addr),
+        .wr_data({op_y, op_x}),
+        .rd_clk(clk),
+        .rd_addr(tail_ptr),
+        .rd_data({tail_y, tail_x})
+    );
+
+    // Direction of the move out of each ring slot, for the tail's sprite,
+    // as in snake_game. W_END waits a clock after tail_ptr moves for both
+    // RAMs to catch up.
+    dual_port_ram #(
+        .DATA_WIDTH(2),
+        .ADDR_WIDTH(BODY_ADDR_BITS)
+    ) exit_ram (
+        .wr_clk(clk),
+        .wr_en(body_wr_en),
+        .wr_addr((w_state == W_LAYOUT) ? init_idx : head_ptr),
+        .wr_data((w_state == W_LAYOUT) ? DIR_RIGHT : curr_direction),
+        .rd_clk(clk),
+        .rd_addr(tail_ptr),
+        .rd_data(tail_dir)
+    );
+
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n)
+            end_settled <= 0;
+        else
+            end_settled <= w_state == W_END;
+    end
+
+    // Next head position and border check for the pending move (the self
+    // check needs the cell from SDRAM and is done in W_PROBE)
+    logic [WX_BITS-1:0] next_x;
+    logic [WY_BITS-1:0] next_y;
+    logic hit_border;
+
+    always_comb begin
+        next_x = head_x;
+        next_y = head_y;
+        case (move_dir)
+            DIR_RIGHT: next_x = head_x + 1'b1;       // Wraps around the world
+            DIR_LEFT:  next_x = head_x - 1'b1;
+            DIR_DOWN:  next_y = head_y + 1'b1;
+            DIR_UP:    next_y = head_y - 1'b1;
+        endcase
+
+        hit_border = border_visible && (
+            (int'(head_x) == BORDER_SIZE - 1 && move_dir == DIR_LEFT) ||
+            (int'(head_x) == WORLD_WIDTH - BORDER_SIZE && move_dir == DIR_RIGHT) ||
+            (int'(head_y) == BORDER_SIZE - 1 && move_dir == DIR_UP) ||
+            (int'(head_y) == WORLD_HEIGHT - BORDER_SIZE && move_dir == DIR_DOWN)
+        );
+    end
+
+    assign extend = mv_grows && snake_length < (BODY_ADDR_BITS+1)'(MAX_SNAKE_LEN);
+
+    // LFSR for apple candidates; steps once per candidate, so the apple
+    // sequence depends only on the seed and the moves played
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n) begin
+            lfsr <= LFSR_SEED;  // Initial seed
+        end else if (w_state == W_APPLE && (!cand_ok || (!op_valid && !eng_active))) begin
+            lfsr <= {lfsr[14:0], lfsr[15] ^ lfsr[13] ^ lfsr[12] ^ lfsr[10]};
+        end
+    end
+
+    assign running = w_state != W_CLEAR && w_state != W_LAYOUT && w_state != W_OVER;
+
+    // Game tick and direction control (see snake_control). A move falls due
+    // every game_speed frames and is taken once the engine is waiting for
+    // it. A turn into the snake's own body counts for the turn latency; that
+    // is only found out in W_PROBE. A move's state is committed when its
+    // last SDRAM write (the new head, or the new tail) is done.
+    snake_control #(
+        .SPEED_BITS(SPEED_BITS),
+        .TURN_QUEUE_DEPTH(TURN_QUEUE_DEPTH)
+    ) control_inst (
+        .clk(clk),
+        .reset_n(reset_n),
+        .frame_tick(frame_tick),
+        .speed(game_speed),
+        .ready(w_state == W_RUN || w_state == W_OVER),
+        .game_tick(game_tick),
+        .KEY(KEY),
+        .turns_on(running),
+        .steer_valid(1'b0),
+        .steer_dir(DIR_RIGHT),
+        .take(w_state == W_RUN && game_tick),
+        .move_ok(!hit_border),
+        .move_dir(move_dir),
+        .curr_direction(curr_direction),
+        .turn_lat_min(turn_lat_min),
+        .turn_lat_max(turn_lat_max),
+        .turn_lat_avg(turn_lat_avg),
+        .turns_dropped(turns_dropped),
+        .move_commit(eng_done && (w_state == W_END ||
+                                  (w_state == W_HEAD && snake_length == 1 && !extend))),
+        .apple(eng_done && w_state == W_HEAD && mv_grows),
+        .perf_address(perf_address),
+        .perf_read(perf_read),
+        .perf_readdata(perf_readdata),
+        .perf_write(perf_write),
+        .perf_writedata(perf_writedata)
+    );
+
+    //-------------------------------------------------------------------------
+    // Camera: viewport origin keeping the head centred, clamped to the world
+    //-------------------------------------------------------------------------
+    logic [WX_BITS-1:0] cam_x, cam_x_next;
+    logic [WY_BITS-1:0] cam_y, cam_y_next;
+
+    always_comb begin
+        if (int'(head_x) < GRID_WIDTH / 2)
+            cam_x_next = 0;
+        else if (int'(head_x) >= WORLD_WIDTH - GRID_WIDTH / 2)
+            cam_x_next = WX_BITS'(WORLD_WIDTH - GRID_WIDTH);
+        else
+            cam_x_next = head_x - WX_BITS'(GRID_WIDTH / 2);
+
+        if (int'(head_y) < GRID_HEIGHT / 2)
+            cam_y_next = 0;
+        else if (int'(head_y) >= WORLD_HEIGHT - GRID_HEIGHT / 2)
+            cam_y_next = WY_BITS'(WORLD_HEIGHT - GRID_HEIGHT);
+        else
+            cam_y_next = head_y - WY_BITS'(GRID_HEIGHT / 2);
+    end
+
+    // Border visibility switch - using asynchronous reset
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n)
+            border_visible <= 1'b1;  // Border visible by default
+        else
+            border_visible <= SW[0];  // SW[0] controls border visibility
+    end
+
+    // Game engine - using asynchronous reset
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n) begin
+            w_state <= W_CLEAR;
+            clear_addr <= 0;
+            init_idx <= 0;
+            snake_length <= (BODY_ADDR_BITS+1)'(INIT_SNAKE_LEN);
+            game_speed <= SPEED_BITS'(SPEED_MAX);
+            score <= 0;
+            head_x <= WX_BITS'(WORLD_WIDTH / 2);
+            head_y <= WY_BITS'(WORLD_HEIGHT / 2);
+            head_ptr <= 0;
+            tail_ptr <= 0;
+            mv_x <= 0;
+            mv_y <= 0;
+            mv_grows <= 0;
+            neck_dir <= DIR_RIGHT;
+            apple_x <= WX_BITS'(WORLD_WIDTH / 2 - GRID_WIDTH / 4);
+            apple_y <= WY_BITS'(WORLD_HEIGHT / 2 - GRID_HEIGHT / 4);
+            cand_x <= 0;
+            cand_y <= 0;
+            cand_ok <= 0;
+            apple_tries <= 0;
+            apple_scan <= 0;
+            scan_x <= 0;
+            scan_y <= 0;
+            apple_valid <= 0;
+        end else begin
+            case (w_state)
+                W_CLEAR: begin
+                    if (eng_done) begin
+                        clear_addr <= clear_addr + CLEAR_BITS'(CLEAR_CHUNK);
+                        if (clear_addr == CLEAR_BITS'(WORLD_WORDS - CLEAR_CHUNK)) begin
+                            init_idx <= 0;
+                            w_state <= W_LAYOUT;
+                        end
+                    end
+                end
+
+                W_LAYOUT: begin
+                    // Initial snake at the centre of the world, pointing
+                    // right, and the first apple up and to the left of it
+                    if (eng_done) begin
+                        if (init_idx == BODY_ADDR_BITS'(INIT_SNAKE_LEN - 1)) begin
+                            head_x <= WX_BITS'(WORLD_WIDTH / 2);
+                            head_y <= WY_BITS'(WORLD_HEIGHT / 2);
+                            head_ptr <= init_idx;
+                            tail_ptr <= 0;
+                            cand_x <= WX_BITS'(WORLD_WIDTH / 2 - GRID_WIDTH / 4);
+                            cand_y <= WY_BITS'(WORLD_HEIGHT / 2 - GRID_HEIGHT / 4);
+                            cand_ok <= 1;
+                            apple_tries <= 0;
+                            apple_scan <= 0;
+                            apple_valid <= 0;
+                            w_state <= W_APPLE;
+                        end else begin
+                            init_idx <= init_idx + 1'b1;
+                        end
+                    end
+                end
+
+                W_APPLE: begin
+                    // Random cell of the apple window: the viewport for the
+                    // current head less APPLE_MARGIN cells at each edge, which
+                    // keeps the apple clear of the status line and on screen
+                    // when the camera follows the next move. Border cells and
+                    // occupied cells are passed over. After APPLE_TRIES misses
+                    // the window is scanned cell by cell; if it is full the
+                    // game goes on without an apple and the next move tries
+                    // again.
+                    if (!cand_ok || (!op_valid && !eng_active)) begin
+                        cand_ok <= 1;
+                        if (apple_scan) begin
+                            if (scan_x == X_BITS'(APPLE_W - 1) && scan_y == Y_BITS'(APPLE_H - 1)) begin
+                                w_state <= W_RUN;
+                            end else if (scan_x == X_BITS'(APPLE_W - 1)) begin
+                                scan_x <= 0;
+                                scan_y <= scan_y + 1'b1;
+                                cand_x <= cam_x_next + WX_BITS'(APPLE_MARGIN);
+                                cand_y <= cand_y + 1'b1;
+                            end else begin
+                                scan_x <= scan_x + 1'b1;
+                                cand_x <= cand_x + 1'b1;
+                            end
+                        end else if (apple_tries == TRIES_BITS'(APPLE_TRIES)) begin
+                            apple_scan <= 1;
+                            scan_x <= 0;
+                            scan_y <= 0;
+                            cand_x <= cam_x_next + WX_BITS'(APPLE_MARGIN);
+                            cand_y <= cam_y_next + WY_BITS'(APPLE_MARGIN);
+                        end else begin
+                            cand_x <= cam_x_next + WX_BITS'(APPLE_MARGIN + ((32'(lfsr[7:0]) * APPLE_W) >> 8));
+                            cand_y <= cam_y_next + WY_BITS'(APPLE_MARGIN + ((32'(lfsr[15:8]) * APPLE_H) >> 8));
+                            apple_tries <= apple_tries + 1'b1;
+                        end
+                    end else if (eng_done) begin
+                        if (rd_code.kind == TILE_EMPTY)
+                            w_state <= W_APPLE_SET;
+                        else
+                            cand_ok <= 0;
+                    end
+                end
+
+                W_APPLE_SET: begin
+                    if (eng_done) begin
+                        apple_x <= cand_x;
+                        apple_y <= cand_y;
+                        apple_valid <= 1;
+                        w_state <= W_RUN;
+                    end
+                end
+
+                W_RUN: begin
+                    if (game_tick) begin
+                        if (hit_border) begin
+                            w_state <= W_OVER;
+                        end else begin
+                            mv_x <= next_x;
+                            mv_y <= next_y;
+                            mv_grows <= apple_valid && next_x == apple_x && next_y == apple_y;
+                            neck_dir <= curr_direction;
+                            w_state <= W_PROBE;
+                        end
+                    end
+                end
+
+                W_PROBE: begin
+                    // The tail cell is allowed because it is vacated in the
+                    // same move unless the snake grows
+                    if (eng_done) begin
+                        if ((rd_code.kind == TILE_HEAD || rd_code.kind == TILE_BODY ||
+                             rd_code.kind == TILE_TAIL) &&
+                            !(mv_x == tail_x && mv_y == tail_y && !extend))
+                            w_state <= W_OVER;
+                        else
+                            w_state <= W_NECK;
+                    end
+                end
+
+                // Redraw order as in snake_game: the tail is cleared after
+                // the neck (a length-1 snake) and before the new head
+                // (following the tail)
+                W_NECK: begin
+                    if (eng_done)
+                        w_state <= extend ? W_HEAD : W_TAIL;
+                end
+
+                W_TAIL: begin
+                    if (eng_done)
+                        w_state <= W_HEAD;
+                end
+
+                W_HEAD: begin
+                    if (eng_done) begin
+                        head_x <= mv_x;
+                        head_y <= mv_y;
+                        head_ptr <= head_ptr + 1'b1;
+                        if (!extend)
+                            tail_ptr <= tail_ptr + 1'b1;
+                        if (mv_grows) begin
+                            if (extend)
+                                snake_length <= snake_length + 1'b1;
+                            if (score != 10'd999)
+                                score <= score + 1'b1;
+                            if (game_speed >= SPEED_BITS'(SPEED_MIN + GAME_SPEED_DECREMENT))
+                                game_speed <= game_speed - SPEED_BITS'(GAME_SPEED_DECREMENT);
+                            apple_valid <= 0;
+                        end
+                        // A new apple after this move: the last one was
+                        // eaten, or there was none
+                        if (mv_grows || !apple_valid) begin
+                            cand_ok <= 0;
+                            apple_tries <= 0;
+                            apple_scan <= 0;
+                        end
+                        // A length-1 snake's tail is its head
+                        if (snake_length != 1 || extend)
+                            w_state <= W_END;
+                        else
+                            w_state <= (mv_grows || !apple_valid) ? W_APPLE : W_RUN;
+                    end
+                end
+
+                W_END: begin
+                    if (eng_done)
+                        w_state <= apple_valid ? W_RUN : W_APPLE;
+                end
+
+                W_OVER: begin
+                    if (game_tick) begin
+                        snake_length <= (BODY_ADDR_BITS+1)'(INIT_SNAKE_LEN);
+                        game_speed <= SPEED_BITS'(SPEED_MAX);
+                        score <= 0;
+                        clear_addr <= 0;
+                        apple_valid <= 0;
+                        w_state <= W_CLEAR;
+                    end
+                end
+
+                default: w_state <= W_CLEAR;
+            endcase
+        end
+    end
+
+    //-------------------------------------------------------------------------
+    // Line fetch requests, pixel side: the renderer's cell row (from its
+    // tile map address) moving on to row r asks for row r; the end of
+    // vertical sync asks for row 0. A request is a toggle plus the row,
+    // which holds still until the next request a line or more later.
+    //-------------------------------------------------------------------------
+    logic [X_BITS+Y_BITS-1:0] render_addr;
+    logic [Y_BITS-1:0] render_row, render_row_d;
+    logic v_sync_d;
+    logic fetch_toggle;
+    logic [Y_BITS-1:0] fetch_row;
+
+    assign render_row = render_addr[X_BITS +: Y_BITS];
+
+    always_ff @(posedge pixel_clk or negedge pixel_reset_n) begin
+        if (~pixel_reset_n) begin
+            render_row_d <= 0;
+            v_sync_d <= ~V_POL;
+            fetch_toggle <= 0;
+            fetch_row <= 0;
+        end else begin
+            render_row_d <= render_row;
+            v_sync_d <= vga_v_sync;
+            if (v_sync_d == V_POL && vga_v_sync != V_POL) begin
+                fetch_row <= 0;
+                fetch_toggle <= ~fetch_toggle;
+            end else if (render_row != render_row_d && render_row != 0 &&
+                         int'(render_row) < GRID_HEIGHT) begin
+                fetch_row <= render_row;
+                fetch_toggle <= ~fetch_toggle;
+            end
+        end
+    end
+
+    //-------------------------------------------------------------------------
+    // Line fetch, clk side. The row's words start at the 16-cell boundary
+    // below cam_x (an 8-word burst boundary), so 2 bursts cover an aligned
+    // viewport and 3 any other. Each line cache entry holds two viewport
+    // cells; for an odd cam_x they straddle two SDRAM words.
+    //-------------------------------------------------------------------------
+    logic [2:0] fetch_toggle_sync;
+    logic fetch_start;
+    logic fetch_active;                              // Words still coming back
+    logic [Y_BITS-1:0] fetch_vrow;                   // Viewport row being fetched
+    logic [4:0] fetch_words;                         // Words received so far
+    cell_t prev_hi;                                  // Odd cell of the previous word
+    logic [WY_BITS-1:0] fetch_y;
+
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n)
+            fetch_toggle_sync <= 3'b000;
+        else
+            fetch_toggle_sync <= {fetch_toggle_sync[1:0], fetch_toggle};
+    end
+
+    assign fetch_start = fetch_toggle_sync[2] != fetch_toggle_sync[1];
+    assign fetch_y = cam_y + WY_BITS'(fetch_vrow);
+    assign fetch_addr = cell_word({cam_x[WX_BITS-1:4], 4'b0000}, fetch_y);
+    assign fetch_len = (cam_x[3:0] == 0) ? 11'd16 : 11'd24;
+
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n) begin
+            fetch_req <= 0;
+            fetch_active <= 0;
+            fetch_vrow <= 0;
+            fetch_words <= 0;
+            prev_hi <= CELL_EMPTY;
+            cam_x <= 0;
+            cam_y <= 0;
+        end else begin
+            if (fetch_start) begin
+                fetch_vrow <= fetch_row;
+                fetch_req <= 1;
+                if (fetch_row == 0) begin
+                    cam_x <= cam_x_next;
+                    cam_y <= cam_y_next;
+                end
+            end else if (fetch_ack) begin
+                fetch_req <= 0;
+                fetch_active <= 1;
+                fetch_words <= 0;
+            end
+
+            if (fetch_rvalid) begin
+                fetch_words <= fetch_words + 1'b1;
+                prev_hi <= cell_t'(sd_rdata[14:8]);
+                if (11'(fetch_words) == fetch_len - 1'b1)
+                    fetch_active <= 0;
+            end
+        end
+    end
+
+    // Line cache (M9K): two rows of GRID_WIDTH/2 entries, row r in half
+    // r[0]. Entry j holds viewport cells 2j (low) and 2j + 1 (high).
+    logic [X_BITS:0] lc_index;                       // Entry of the word's low cell, may run past the row
+    logic lc_wr_en;
+    logic [X_BITS-1:0] lc_wr_addr;
+    logic [2*$bits(cell_t)-1:0] lc_wr_data;
+    logic [X_BITS-1:0] lc_rd_addr;
+    logic [2*$bits(cell_t)-1:0] lc_rd_data;
+    logic lc_rd_odd;
+
+    always_comb begin
+        logic [WX_BITS-1:0] wx;
+        cell_t lo, hi;
+
+        lc_index = (X_BITS+1)'(fetch_words) - (X_BITS+1)'(cam_x[3:1]) - (X_BITS+1)'(cam_x[0]);
+        lc_wr_en = fetch_rvalid &&
+                   (X_BITS+1)'(fetch_words) >= (X_BITS+1)'(cam_x[3:1]) + (X_BITS+1)'(cam_x[0]) &&
+                   int'(lc_index) < GRID_WIDTH / 2;
+        lc_wr_addr = {fetch_vrow[0], lc_index[X_BITS-2:0]};
+
+        lo = cam_x[0] ? prev_hi : cell_t'(sd_rdata[6:0]);
+        hi = cell_t'(cam_x[0] ? sd_rdata[6:0] : sd_rdata[14:8]);
+
+        // The border is drawn over anything the snake leaves on it
+        wx = cam_x + WX_BITS'({lc_index, 1'b0});
+        if (border_visible && is_border_cell(wx, fetch_y))
+            lo = CELL_BORDER;
+        if (border_visible && is_border_cell(wx + 1'b1, fetch_y))
+            hi = CELL_BORDER;
+        lc_wr_data = {hi, lo};
+    end
+
+    dual_port_ram #(
+        .DATA_WIDTH(2 * $bits(cell_t)),
+        .ADDR_WIDTH(X_BITS)
+    ) line_cache (
+        .wr_clk(clk),
+        .wr_en(lc_wr_en),
+        .wr_addr(lc_wr_addr),
+        .wr_data(lc_wr_data),
+        .rd_clk(pixel_clk),
+        .rd_addr(lc_rd_addr),
+        .rd_data(lc_rd_data)
+    );
+
+    assign lc_rd_addr = {render_row[0], render_addr[X_BITS-1:1]};
+
+    always_ff @(posedge pixel_clk) begin
+        lc_rd_odd <= render_addr[0];
+    end
+
+    // Video, shared with snake_game; the renderer's tile map reads come
+    // from the line cache
+    snake_display #(
+        .VIDEO_MODE(VIDEO_MODE),
+        .GRID_WIDTH(GRID_WIDTH),
+        .GRID_HEIGHT(GRID_HEIGHT),
+        .GAME_SPEED_MAX(SPEED_MAX)
+    ) display_inst (
+        .clk(clk),
+        .reset_n(reset_n),
+        .pixel_clk(pixel_clk),
+        .pixel_reset_n(pixel_reset_n),
+        .v_sync(vga_v_sync),
+        .frame_tick(frame_tick),
+        .tile_addr(render_addr),
+        .tile_code(lc_rd_odd ? lc_rd_data[2*$bits(cell_t)-1:$bits(cell_t)] :
+                               lc_rd_data[$bits(cell_t)-1:0]),
+        .score(13'(score)),
+        .length(13'(snake_length)),
+        .speed(13'(game_speed)),
+        .game_over(w_state == W_OVER),
+        .VGA_R(VGA_R),
+        .VGA_G(VGA_G),
+        .VGA_B(VGA_B),
+        .VGA_HS(VGA_HS),
+        .VGA_VS(VGA_VS)
+    );
+
+endmodule
@@ -0,0 +1,285 @@
+// World mode of DE10_Lite_Snake on the SDRAM behavioral model.
+//
+// Two worlds play FRAMES frames side by side, with the same keys (a couple
+// of turns) and SIM_SPEEDUP moving the snake every frame:
+//   - the default 1024x1024 world, cleared in the first frame
+//   - a 64x64 world, where the snake reaches the right-hand edge: the
+//     camera stops at the world's edge, the border comes into view and the
+//     snake runs into it
+// Every frame in which the engine is idle when the camera is taken, each
+// checks:
+//   - the camera is the head's cell less half the viewport, clamped to the
+//     world
+//   - each line's cell row is in the line cache before the renderer reads
+//     its first cell (no fetch outstanding in the last few pixel clocks
+//     before display enable rises)
+//   - the centre pixel of every cell on screen showing the head, the apple
+//     or the border has that sprite's colours (cell row 0, under the
+//     status line, is left out, and so is everything after a game over,
+//     when GAME OVER is written across the screen)
+// and at the end that the SDRAM model saw no protocol errors, and that the
+// head, the apple and (in the small world) the border and a clamped camera
+// were all seen.
+module snake_world_tb #(
+    parameter snake_pkg::video_mode_sel_t VIDEO_MODE = snake_pkg::VIDEO_640X480,
+    parameter FRAMES = 48,
+    parameter SIM_SPEEDUP = 14                       // See DE10_Lite_Snake; 14 moves every frame
+)();
+    // Testbench signals
+    logic clk;
+    logic [1:0] KEY;
+    logic [9:0] SW;
+
+    localparam snake_pkg::video_mode_t MODE = snake_pkg::video_mode(VIDEO_MODE);
+    localparam GRID_SIZE = MODE.cell_size;
+    localparam GRID_WIDTH = MODE.h_pixels / GRID_SIZE;
+    localparam GRID_HEIGHT = MODE.v_pixels / GRID_SIZE;
+    localparam int WORLD_SIZES [2] = '{1024, 64};
+
+    // Clock generation
+    initial begin
+        clk = 0;
+        forever #10 clk = ~clk; // 50MHz clock
+    end
+
+    for (genvar w = 0; w < 2; w++) begin : world
+        localparam WORLD_SIZE = WORLD_SIZES[w];
+
+        logic [9:0] LEDR;
+        logic [7:0] HEX0, HEX1, HEX2, HEX3, HEX4, HEX5;
+        logic [3:0] VGA_R;
+        logic [3:0] VGA_G;
+        logic [3:0] VGA_B;
+        logic VGA_HS;
+        logic VGA_VS;
+        logic [12:0] DRAM_ADDR;
+        logic [1:0] DRAM_BA;
+        logic DRAM_CAS_N, DRAM_CKE, DRAM_CLK, DRAM_CS_N;
+        logic DRAM_LDQM, DRAM_RAS_N, DRAM_UDQM, DRAM_WE_N;
+        wire [15:0] DRAM_DQ;
+
+        // Instantiate the board top level in world mode
+        DE10_Lite_Snake #(
+            .VIDEO_MODE(VIDEO_MODE),
+            .WORLD_MODE(1),
+            .WORLD_WIDTH(WORLD_SIZE),
+            .WORLD_HEIGHT(WORLD_SIZE),
+            .SIM_SPEEDUP(SIM_SPEEDUP)
+        ) dut (
+            .ADC_CLK_10(1'b0),
+            .MAX10_CLK1_50(clk),
+            .MAX10_CLK2_50(1'b0),
+            .KEY(KEY),
+            .SW(SW),
+            .LEDR(LEDR),
+            .HEX0(HEX0),
+            .HEX1(HEX1),
+            .HEX2(HEX2),
+            .HEX3(HEX3),
+            .HEX4(HEX4),
+            .HEX5(HEX5),
+            .VGA_R(VGA_R),
+            .VGA_G(VGA_G),
+            .VGA_B(VGA_B),
+            .VGA_HS(VGA_HS),
+            .VGA_VS(VGA_VS),
+            .DRAM_ADDR(DRAM_ADDR),
+            .DRAM_BA(DRAM_BA),
+            .DRAM_CAS_N(DRAM_CAS_N),
+            .DRAM_CKE(DRAM_CKE),
+            .DRAM_CLK(DRAM_CLK),
+            .DRAM_CS_N(DRAM_CS_N),
+            .DRAM_DQ(DRAM_DQ),
+            .DRAM_LDQM(DRAM_LDQM),
+            .DRAM_RAS_N(DRAM_RAS_N),
+            .DRAM_UDQM(DRAM_UDQM),
+            .DRAM_WE_N(DRAM_WE_N)
+        );
+
+        // SDRAM
+        sdram_model sdram (
+            .clk(DRAM_CLK),
+            .cke(DRAM_CKE),
+            .cs_n(DRAM_CS_N),
+            .ras_n(DRAM_RAS_N),
+            .cas_n(DRAM_CAS_N),
+            .we_n(DRAM_WE_N),
+            .ba(DRAM_BA),
+            .addr(DRAM_ADDR),
+            .dqm({DRAM_UDQM, DRAM_LDQM}),
+            .dq(DRAM_DQ)
+        );
+
+        // Line fetch deadline: nothing outstanding from the renderer's read
+        // of the line's first cell (3 pixel clocks ahead) to the start of
+        // the line
+        int late_lines = 0;
+        logic [3:0] fetch_busy;
+
+        initial fetch_busy = '0;
+
+        always @(posedge dut.world_mode.snake_inst.pixel_clk) begin
+            fetch_busy <= {fetch_busy[2:0], dut.world_mode.snake_inst.sd_ready &&
+                           (dut.world_mode.snake_inst.fetch_req ||
+                            dut.world_mode.snake_inst.fetch_active ||
+                            dut.world_mode.snake_inst.fetch_start)};
+        end
+
+        always @(posedge dut.world_mode.snake_inst.display_inst.vga_disp_ena) begin
+            if (fetch_busy != 0)
+                late_lines++;
+        end
+
+        // The frame's camera and world, taken after the row 0 fetch
+        int frame = 0;
+        logic frame_ok = 0;                          // Engine idle, world and camera settled
+        int cam_x, cam_y;
+        int head_x, head_y;
+        int apple_x, apple_y;
+        logic apple_valid;
+        int errors = 0;
+        int cam_checks = 0;
+        int edge_frames = 0;                         // Frames with the camera stopped at an edge
+        logic game_ended = 0;                        // GAME OVER may cover the cells from here on
+
+        always @(posedge clk) begin
+            if (dut.world_mode.snake_inst.w_state == dut.world_mode.snake_inst.W_OVER)
+                game_ended = 1;
+        end
+
+        function automatic int clamp_cam(input int head, input int grid);
+            if (head < grid / 2)
+                return 0;
+            if (head >= WORLD_SIZE - grid / 2)
+                return WORLD_SIZE - grid;
+            return head - grid / 2;
+        endfunction
+
+        initial begin
+            forever begin
+                // End of vertical sync: the camera for the coming frame is
+                // taken with the row 0 fetch a few clocks later
+                wait (VGA_VS == MODE.v_pol);
+                wait (VGA_VS != MODE.v_pol);
+                repeat (20) @(posedge clk);
+                frame++;
+                line = -1;
+                frame_ok = SW[0] && !game_ended &&
+                           dut.world_mode.snake_inst.w_state == dut.world_mode.snake_inst.W_RUN;
+                cam_x = dut.world_mode.snake_inst.cam_x;
+                cam_y = dut.world_mode.snake_inst.cam_y;
+                head_x = dut.world_mode.snake_inst.head_x;
+                head_y = dut.world_mode.snake_inst.head_y;
+                apple_x = dut.world_mode.snake_inst.apple_x;
+                apple_y = dut.world_mode.snake_inst.apple_y;
+                apple_valid = dut.world_mode.snake_inst.apple_valid;
+                if (frame_ok) begin
+                    cam_checks++;
+                    if (cam_x != clamp_cam(head_x, GRID_WIDTH) || cam_y != clamp_cam(head_y, GRID_HEIGHT)) begin
+                        errors++;
+                        $display("World %0d, frame %0d: camera (%0d, %0d) for head (%0d, %0d)",
+                                 WORLD_SIZE, frame, cam_x, cam_y, head_x, head_y);
+                    end
+                    if (cam_x == 0 || cam_x == WORLD_SIZE - GRID_WIDTH ||
+                        cam_y == 0 || cam_y == WORLD_SIZE - GRID_HEIGHT)
+                        edge_frames++;
+                end
+            end
+        end
+
+        // Cell centre pixels, on the VGA outputs
+        int head_checks = 0;
+        int apple_checks = 0;
+        int border_checks = 0;
+        int col = 0;
+        int line = -1;
+        logic de_prev = 0;
+
+        always @(posedge dut.world_mode.snake_inst.pixel_clk) begin
+            logic de;
+            int wx, wy;
+            logic [11:0] rgb;
+
+            de = dut.world_mode.snake_inst.display_inst.render_inst.de_out;
+            if (de) begin
+                if (!de_prev) begin
+                    line++;
+                    col = 0;
+                end
+                rgb = {VGA_R, VGA_G, VGA_B};
+                if (frame_ok && col % GRID_SIZE == GRID_SIZE / 2 && line % GRID_SIZE == GRID_SIZE / 2 &&
+                    line >= GRID_SIZE) begin
+                    wx = cam_x + col / GRID_SIZE;
+                    wy = cam_y + line / GRID_SIZE;
+                    if (wx == 0 || wx == WORLD_SIZE - 1 || wy == 0 || wy == WORLD_SIZE - 1) begin
+                        border_checks++;
+                        if (rgb != 12'h00F && rgb != 12'h008) begin
+                            errors++;
+                            $display("World %0d, frame %0d: border cell (%0d, %0d) pixel is %h",
+                                     WORLD_SIZE, frame, wx, wy, rgb);
+                        end
+                    end else if (wx == head_x && wy == head_y) begin
+                        head_checks++;
+                        if (rgb != 12'h0F0) begin
+                            errors++;
+                            $display("World %0d, frame %0d: head cell (%0d, %0d) pixel is %h",
+                                     WORLD_SIZE, frame, wx, wy, rgb);
+                        end
+                    end else if (apple_valid && wx == apple_x && wy == apple_y) begin
+                        apple_checks++;
+                        if (rgb != 12'hF00 && rgb != 12'h800) begin
+                            errors++;
+                            $display("World %0d, frame %0d: apple cell (%0d, %0d) pixel is %h",
+                                     WORLD_SIZE, frame, wx, wy, rgb);
+                        end
+                    end
+                end
+                col++;
+            end
+            de_prev = de;
+        end
+
+        // Results for this world
+        function automatic int failures();
+            int f;
+            $display("World %0dx%0d after %0d frames: head (%0d, %0d), camera (%0d, %0d), score %0d",
+                     WORLD_SIZE, WORLD_SIZE, frame, head_x, head_y, cam_x, cam_y,
+                     dut.world_mode.snake_inst.score);
+            $display("  checks: camera %0d (%0d at an edge), head %0d, apple %0d, border %0d; errors %0d",
+                     cam_checks, edge_frames, head_checks, apple_checks, border_checks, errors);
+            $display("  lines started with a fetch outstanding: %0d; SDRAM protocol errors: %0d",
+                     late_lines, sdram.errors);
+            f = errors + late_lines + sdram.errors;
+            if (head_checks == 0 || apple_checks == 0 || cam_checks == 0)
+                f++;
+            if (WORLD_SIZE <= 2 * GRID_WIDTH && (border_checks == 0 || edge_frames == 0))
+                f++;
+            return f;
+        endfunction
+    end
+
+    // Test sequence
+    initial begin
+        int failed;
+
+        KEY = 2'b11;  // Keys are active low
+        SW = 10'b0;   // Game held in reset
+        repeat (100) @(posedge clk);
+        SW[0] = 1;    // Border visible, game running
+
+        for (int frame = 0; frame < FRAMES; frame++) begin
+            // Turn clockwise then back, a few frames each
+            KEY[0] = !(frame >= 10 && frame < 13);
+            KEY[1] = !(frame >= 20 && frame < 23);
+            wait (world[0].VGA_VS == MODE.v_pol);
+            wait (world[0].VGA_VS != MODE.v_pol);
+        end
+        repeat (20) @(posedge clk);
+
+        failed = world[0].failures() + world[1].failures();
+        if (failed != 0)
+            $error("snake_world_tb FAILED");
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,138 @@
+// Sprite ROM (M9K) for the snake renderer: NUM_SPRITES bitmaps of
+// GRID_SIZE x GRID_SIZE pixels at 2 bits per pixel, one sprite row per word.
+// Word {sprite, y} holds row y of the sprite with pixel x in bits
+// [2x+1:2x], so the renderer can shift a row out one pixel at a time.
+//
+// The bitmaps are drawn at elaboration from the shapes below, scaled to the
+// cell size, so every video mode gets its own set without a .mif file. The
+// 2-bit values index a 4-color bank of the renderer's palette:
+//   background/border - 0 black, 1 brick, 2 mortar
+//   snake             - 0 black, 1 head, 2 body, 3 eyes
+//   apple             - 0 black, 1 skin, 2 shade, 3 leaf
+// Read data appears one clock after addr is presented.
+module sprite_rom
+    import snake_pkg::*;
+#(
+    parameter GRID_SIZE = 20
+)(
+    input  logic clk,
+    input  logic [$clog2(NUM_SPRITES)+$clog2(GRID_SIZE)-1:0] addr,
+    output logic [2*GRID_SIZE-1:0] row
+);
+
+    localparam S = GRID_SIZE;
+    localparam CELL_BITS = $clog2(GRID_SIZE);
+    localparam ADDR_BITS = $clog2(NUM_SPRITES) + CELL_BITS;
+    localparam M = S / 5;                            // Margin either side of the snake's body
+    localparam E = (S / 10 > 0) ? S / 10 : 1;        // Eye size
+
+    // Pixel (x, y) of a sprite facing dir, in the right-facing sprite
+    function automatic int facing_u(input direction_t dir, input int x, input int y);
+        case (dir)
+            DIR_LEFT: return S - 1 - x;
+            DIR_DOWN: return y;
+            DIR_UP:   return S - 1 - y;
+            default:  return x;
+        endcase
+    endfunction
+
+    function automatic int facing_v(input direction_t dir, input int x, input int y);
+        return (dir == DIR_DOWN || dir == DIR_UP) ? x : y;
+    endfunction
+
+    // Body band joining the cell's centre to the sides in joins
+    // ({up, left, down, right}, as direction_t bit positions)
+    function automatic logic on_body(input logic [3:0] joins, input int x, input int y);
+        logic across_x, across_y;
+        across_x = y >= M && y < S - M;
+        across_y = x >= M && x < S - M;
+        return (across_x && across_y) ||
+               (joins[DIR_RIGHT] && across_x && x >= S / 2) ||
+               (joins[DIR_LEFT]  && across_x && x < S / 2) ||
+               (joins[DIR_DOWN]  && across_y && y >= S / 2) ||
+               (joins[DIR_UP]    && across_y && y < S / 2);
+    endfunction
+
+    function automatic logic [1:0] sprite_pixel(input int sprite, input int x, input int y);
+        int u, v, dx, dy, r;
+
+        if (sprite == SPR_BORDER) begin
+            // Bricks, half a cell high, every other course offset by half
+            if (y % (S / 2) == S / 2 - 1 ||
+                (x + ((y / (S / 2)) % 2) * (S / 2)) % S == S - 1)
+                return 2'd2;
+            return 2'd1;
+        end
+
+        if (sprite == SPR_APPLE) begin
+            // Round apple, shaded low right, with a leaf on top
+            if (x >= S / 2 && x < S / 2 + E && y >= S / 10 && y < S / 10 + 2 * E)
+                return 2'd3;
+            dx = 2 * x + 1 - S;
+            dy = 2 * y + 1 - S - S / 5;
+            r = (3 * S) / 4;
+            if (dx * dx + dy * dy > r * r)
+                return 2'd0;
+            return (2 * (dx + dy) > r) ? 2'd2 : 2'd1;
+        end
+
+        if (sprite >= SPR_HEAD && sprite < SPR_HEAD + 4) begin
+            // Body band up to a rounded snout, eyes towards the front
+            u = facing_u(direction_t'(sprite - SPR_HEAD), x, y);
+            v = facing_v(direction_t'(sprite - SPR_HEAD), x, y);
+            if (v < M || v >= S - M || u >= S - M / 2)
+                return 2'd0;
+            if (u >= S - M / 2 - 1 && (v == M || v == S - M - 1))
+                return 2'd0;
+            if (u >= S - M - 2 * E && u < S - M - E &&
+                ((v >= M + E && v < M + 2 * E) || (v >= S - M - 2 * E && v < S - M - E)))
+                return 2'd3;
+            return 2'd1;
+        end
+
+        if (sprite >= SPR_TAIL && sprite < SPR_TAIL + 4) begin
+            // Body band narrowing to a point away from dir_out
+            u = facing_u(direction_t'(sprite - SPR_TAIL), x, y);
+            v = facing_v(direction_t'(sprite - SPR_TAIL), x, y);
+            dy = 2 * v + 1 - S;
+            if (dy < 0)
+                dy = -dy;
+            return (dy * S < (S - 2 * M) * (u + 1)) ? 2'd2 : 2'd0;
+        end
+
+        if (sprite == SPR_BODY_H)
+            return on_body(4'b0101, x, y) ? 2'd2 : 2'd0;
+        if (sprite == SPR_BODY_V)
+            return on_body(4'b1010, x, y) ? 2'd2 : 2'd0;
+
+        if (sprite >= SPR_CORNER && sprite < SPR_CORNER + 4) begin
+            logic [3:0] joins;
+            joins = '0;
+            joins[(sprite - SPR_CORNER) & 2 ? DIR_RIGHT : DIR_LEFT] = 1'b1;
+            joins[(sprite - SPR_CORNER) & 1 ? DIR_DOWN : DIR_UP] = 1'b1;
+            return on_body(joins, x, y) ? 2'd2 : 2'd0;
+        end
+
+        return 2'd0;
+    endfunction
+
+    (* romstyle = "M9K" *) logic [2*S-1:0] rom [0:NUM_SPRITES*(1<<CELL_BITS)-1];
+
+    initial begin
+        for (int sprite = 0; sprite < NUM_SPRITES; sprite++) begin
+            for (int y = 0; y < (1 << CELL_BITS); y++) begin
+                logic [2*S-1:0] bits;
+                bits = '0;
+                for (int x = 0; x < S; x++)
+                    if (y < S)
+                        bits[2*x +: 2] = sprite_pixel(sprite, x, y);
+                rom[ADDR_BITS'(sprite * (1 << CELL_BITS) + y)] = bits;
+            end
+        end
+    end
+
+    always_ff @(posedge clk) begin
+        row <= rom[addr];
+    end
+
+endmodule
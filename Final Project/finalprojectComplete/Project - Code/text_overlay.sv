@@ -0,0 +1,143 @@
+// Character-cell text layer for the snake renderer.
+//
+// A 64x32 character RAM (written from the game clock domain, see
+// text_writer) covers the screen in cells of 8x8 font pixels, each font
+// pixel CHAR_SCALE x CHAR_SCALE screen pixels. Position is tracked with
+// the same display-enable driven counters as the renderer, and a pixel
+// takes two clocks:
+//   stage 1 - character code from the character RAM
+//   stage 2 - glyph pixel from the font ROM
+// so text_pixel and text_box line up with the renderer's stage 2. Code 0
+// is transparent; any other code blanks its cell behind the glyph so text
+// stays readable over the playfield. Screens wider or taller than the RAM
+// show no text past it.
+module text_overlay #(
+    parameter CHAR_SCALE = 2,                        // Screen pixels per font pixel
+    parameter V_POL = 1'b0                           // Vertical sync polarity of the VGA controller
+)(
+    input  logic pixel_clk,
+    input  logic reset_n,
+
+    // Raw timing from the VGA controller
+    input  logic disp_ena,
+    input  logic v_sync,
+
+    // Character RAM write port ({row, col} address, ASCII data)
+    input  logic wr_clk,
+    input  logic wr_en,
+    input  logic [10:0] wr_addr,
+    input  logic [6:0] wr_data,
+
+    output logic text_pixel,                         // Glyph pixel is set
+    output logic text_box                            // Pixel is in a non-blank character cell
+);
+
+    localparam SCALE_BITS = (CHAR_SCALE > 1) ? $clog2(CHAR_SCALE) : 1;
+    localparam logic [SCALE_BITS-1:0] SCALE_LAST = SCALE_BITS'(CHAR_SCALE - 1);
+
+    //-------------------------------------------------------------------------
+    // Stage 0: character position counters
+    //-------------------------------------------------------------------------
+    logic [SCALE_BITS-1:0] sub_x, sub_y;             // Screen pixel within the font pixel
+    logic [2:0] glyph_col, glyph_row;                // Font pixel within the character
+    logic [6:0] char_col;
+    logic [5:0] char_row;
+    logic disp_ena_d;
+
+    always_ff @(posedge pixel_clk or negedge reset_n) begin
+        if (~reset_n) begin
+            sub_x <= 0;
+            glyph_col <= 0;
+            char_col <= 0;
+            sub_y <= 0;
+            glyph_row <= 0;
+            char_row <= 0;
+            disp_ena_d <= 1'b0;
+        end else begin
+            disp_ena_d <= disp_ena;
+
+            if (disp_ena) begin
+                if (sub_x == SCALE_LAST) begin
+                    sub_x <= 0;
+                    glyph_col <= glyph_col + 1'b1;
+                    if (glyph_col == 7 && char_col != 7'h7F)
+                        char_col <= char_col + 1'b1;
+                end else begin
+                    sub_x <= sub_x + 1'b1;
+                end
+            end else begin
+                sub_x <= 0;
+                glyph_col <= 0;
+                char_col <= 0;
+            end
+
+            if (v_sync == V_POL) begin
+                sub_y <= 0;
+                glyph_row <= 0;
+                char_row <= 0;
+            end else if (disp_ena_d && !disp_ena) begin
+                if (sub_y == SCALE_LAST) begin
+                    sub_y <= 0;
+                    glyph_row <= glyph_row + 1'b1;
+                    if (glyph_row == 7 && char_row != 6'h3F)
+                        char_row <= char_row + 1'b1;
+                end else begin
+                    sub_y <= sub_y + 1'b1;
+                end
+            end
+        end
+    end
+
+    //-------------------------------------------------------------------------
+    // Stage 1: character code
+    //-------------------------------------------------------------------------
+    logic [6:0] s1_char;
+    logic [2:0] s1_glyph_col, s1_glyph_row;
+    logic s1_in_ram;
+
+    dual_port_ram #(
+        .DATA_WIDTH(7),
+        .ADDR_WIDTH(11)
+    ) char_ram (
+        .wr_clk(wr_clk),
+        .wr_en(wr_en),
+        .wr_addr(wr_addr),
+        .wr_data(wr_data),
+        .rd_clk(pixel_clk),
+        .rd_addr({char_row[4:0], char_col[5:0]}),
+        .rd_data(s1_char)
+    );
+
+    always_ff @(posedge pixel_clk or negedge reset_n) begin
+        if (~reset_n) begin
+            s1_glyph_col <= 0;
+            s1_glyph_row <= 0;
+            s1_in_ram <= 1'b0;
+        end else begin
+            s1_glyph_col <= glyph_col;
+            s1_glyph_row <= glyph_row;
+            s1_in_ram <= char_col < 64 && char_row < 32;
+        end
+    end
+
+    //-------------------------------------------------------------------------
+    // Stage 2: glyph pixel
+    //-------------------------------------------------------------------------
+    logic glyph_pixel;
+
+    font_rom font_inst (
+        .clk(pixel_clk),
+        .addr({s1_char, s1_glyph_row, s1_glyph_col}),
+        .pixel(glyph_pixel)
+    );
+
+    always_ff @(posedge pixel_clk or negedge reset_n) begin
+        if (~reset_n)
+            text_box <= 1'b0;
+        else
+            text_box <= s1_in_ram && s1_char != 7'd0;
+    end
+
+    assign text_pixel = glyph_pixel && text_box;
+
+endmodule
@@ -0,0 +1,202 @@
+// Status text for the overlay (see text_overlay): writes the score, snake
+// length and speed level along the top character row, and GAME OVER in
+// the middle of the screen, into the overlay's character RAM.
+//
+// The text is refreshed on every update pulse (the frame tick, in vertical
+// blanking): the three numbers are converted to decimal one after another
+// by the iterative bin2bcd (one bit per clock), then the characters are
+// written one per clock, about 80 clocks in all. No divider or modulo is
+// involved, and the pixel side only ever reads characters. After reset the
+// whole RAM is cleared first (code 0 is transparent).
+module text_writer #(
+    parameter H_PIXELS = 640,                        // Screen size, for the text layout
+    parameter V_PIXELS = 480,
+    parameter CHAR_SCALE = 2,                        // Screen pixels per font pixel
+    parameter VALUE_BITS = 13,                       // Width of score, length and speed (4 digits)
+    parameter GAME_SPEED_MAX = 14,                   // Speed level 1 is GAME_SPEED_MAX frames per move
+    parameter OVER_FRAMES = 120                      // Update pulses GAME OVER stays up after a game
+)(
+    input  logic clk,
+    input  logic reset_n,
+    input  logic update,                             // Refresh the text (once per frame)
+    input  logic [VALUE_BITS-1:0] score,
+    input  logic [VALUE_BITS-1:0] length,
+    input  logic [VALUE_BITS-1:0] speed,             // Frames per move
+    input  logic game_over,
+
+    // Character RAM write port ({row, col} address, ASCII data)
+    output logic wr_en,
+    output logic [10:0] wr_addr,
+    output logic [6:0] wr_data
+);
+
+    localparam TEXT_COLS = 64;                       // Character RAM geometry
+    localparam TEXT_ROWS = 32;
+    localparam COLS = H_PIXELS / (8 * CHAR_SCALE);
+    localparam ROWS = (V_PIXELS / (8 * CHAR_SCALE) < TEXT_ROWS) ? V_PIXELS / (8 * CHAR_SCALE) : TEXT_ROWS;
+
+    // Top row, from column STATUS_COL; digits are filled in below
+    localparam STATUS_LEN = 29;
+    localparam [8*STATUS_LEN-1:0] STATUS_TEXT = "SCORE 000  LEN 0000  LEVEL 00";
+    localparam STATUS_ROW = 0;
+    localparam STATUS_COL = 1;
+
+    localparam OVER_LEN = 9;
+    localparam [8*OVER_LEN-1:0] OVER_TEXT = "GAME OVER";
+    localparam OVER_ROW = ROWS / 2;
+    localparam OVER_COL = (COLS - OVER_LEN) / 2;
+    localparam OVER_BITS = $clog2(OVER_FRAMES + 1);
+
+    typedef enum logic [2:0] {
+        T_CLEAR,                                     // Blank the whole character RAM
+        T_IDLE,                                      // Wait for the next update
+        T_CONVERT,                                   // Start converting values[value_sel]
+        T_WAIT,                                      // Wait for its digits
+        T_STATUS,                                    // Write the status row
+        T_OVER                                       // Write the GAME OVER row
+    } text_state_t;
+
+    text_state_t state;
+    logic [10:0] clear_addr;
+    logic [VALUE_BITS-1:0] values [0:2];             // score, length, level at the update
+    logic [1:0] value_sel;                           // Value being converted
+    logic bcd_valid;
+    logic [15:0] bcd;
+    logic [15:0] score_bcd, length_bcd, level_bcd;
+    logic [4:0] col;
+    logic [OVER_BITS-1:0] over_timer;
+    logic over_shown;
+
+    bin2bcd #(
+        .WIDTH(VALUE_BITS),
+        .DIGITS(4)
+    ) bcd_inst (
+        .clk(clk),
+        .reset_n(reset_n),
+        .start(state == T_CONVERT),
+        .bin(values[value_sel]),
+        .busy(),
+        .valid(bcd_valid),
+        .bcd(bcd)
+    );
+
+    function automatic logic [6:0] digit(input logic [3:0] d);
+        return 7'("0") + 7'(d);
+    endfunction
+
+    // Character i of the status row
+    function automatic logic [6:0] status_char(input logic [4:0] i);
+        case (i)
+            6:  return digit(score_bcd[11:8]);
+            7:  return digit(score_bcd[7:4]);
+            8:  return digit(score_bcd[3:0]);
+            15: return digit(length_bcd[15:12]);
+            16: return digit(length_bcd[11:8]);
+            17: return digit(length_bcd[7:4]);
+            18: return digit(length_bcd[3:0]);
+            27: return digit(level_bcd[7:4]);
+            28: return digit(level_bcd[3:0]);
+            default: return 7'(STATUS_TEXT[8*(STATUS_LEN-1-32'(i)) +: 8]);
+        endcase
+    endfunction
+
+    always_comb begin
+        wr_en = 1'b0;
+        wr_addr = {5'(STATUS_ROW), 6'(STATUS_COL) + 6'(col)};
+        wr_data = 7'd0;
+        case (state)
+            T_CLEAR: begin
+                wr_en = 1'b1;
+                wr_addr = clear_addr;
+            end
+            T_STATUS: begin
+                wr_en = 1'b1;
+                wr_data = status_char(col);
+            end
+            T_OVER: begin
+                wr_en = 1'b1;
+                wr_addr = {5'(OVER_ROW), 6'(OVER_COL) + 6'(col)};
+                wr_data = over_shown ? 7'(OVER_TEXT[8*(OVER_LEN-1-32'(col)) +: 8]) : 7'd0;
+            end
+            default: ;
+        endcase
+    end
+
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n) begin
+            state <= T_CLEAR;
+            clear_addr <= 0;
+            for (int i = 0; i < 3; i++)
+                values[i] <= 0;
+            value_sel <= 0;
+            score_bcd <= 0;
+            length_bcd <= 0;
+            level_bcd <= 0;
+            col <= 0;
+            over_timer <= 0;
+            over_shown <= 0;
+        end else begin
+            if (update) begin
+                if (game_over)
+                    over_timer <= OVER_BITS'(OVER_FRAMES);
+                else if (over_timer != 0)
+                    over_timer <= over_timer - 1'b1;
+            end
+
+            case (state)
+                T_CLEAR: begin
+                    clear_addr <= clear_addr + 1'b1;
+                    if (clear_addr == 11'(TEXT_COLS * TEXT_ROWS - 1))
+                        state <= T_IDLE;
+                end
+
+                T_IDLE: begin
+                    if (update) begin
+                        values[0] <= score;
+                        values[1] <= length;
+                        values[2] <= VALUE_BITS'(GAME_SPEED_MAX + 1) - speed;
+                        over_shown <= game_over || over_timer != 0;
+                        value_sel <= 0;
+                        state <= T_CONVERT;
+                    end
+                end
+
+                T_CONVERT: state <= T_WAIT;
+
+                T_WAIT: begin
+                    if (bcd_valid) begin
+                        case (value_sel)
+                            0: score_bcd <= bcd;
+                            1: length_bcd <= bcd;
+                            default: level_bcd <= bcd;
+                        endcase
+                        if (value_sel == 2) begin
+                            col <= 0;
+                            state <= T_STATUS;
+                        end else begin
+                            value_sel <= value_sel + 1'b1;
+                            state <= T_CONVERT;
+                        end
+                    end
+                end
+
+                T_STATUS: begin
+                    col <= col + 1'b1;
+                    if (col == 5'(STATUS_LEN - 1)) begin
+                        col <= 0;
+                        state <= T_OVER;
+                    end
+                end
+
+                T_OVER: begin
+                    col <= col + 1'b1;
+                    if (col == 5'(OVER_LEN - 1))
+                        state <= T_IDLE;
+                end
+
+                default: state <= T_CLEAR;
+            endcase
+        end
+    end
+
+endmodule
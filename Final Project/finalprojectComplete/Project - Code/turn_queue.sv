@@ -0,0 +1,97 @@
+// Pending turn queue for the snake.
+//
+// Every key pulse queues an absolute direction, rotated from the last
+// queued direction (or from the current one when the queue is empty), so
+// quick presses between two moves add up instead of overwriting each other.
+// The game takes one entry per move. Because each entry is a quarter turn
+// from the one before it, consecutive moves can never be a 180-degree
+// reversal onto the neck; two quick presses the same way become two moves
+// (a U-turn) rather than one reversal. A turn that finds the queue full is
+// dropped and counted.
+//
+// Each entry carries the timestamp of its key pulse so the game can measure
+// how long a turn waited before the head moved.
+module turn_queue
+    import snake_pkg::*;
+#(
+    parameter DEPTH = 4,
+    parameter STAMP_BITS = 32
+)(
+    input  logic clk,
+    input  logic reset_n,
+    input  logic clear,                              // Empty the queue (game not running)
+    input  logic rotate_cw,                          // Key pulse: turn clockwise
+    input  logic rotate_ccw,                         // Key pulse: turn counter-clockwise
+    input  direction_t curr_direction,               // Direction the snake is moving in
+    input  logic [STAMP_BITS-1:0] now,               // Timestamp for new entries
+    input  logic pop,                                // Take the oldest entry
+
+    output logic empty,
+    output direction_t turn_dir,                     // Oldest entry
+    output logic [STAMP_BITS-1:0] turn_stamp,
+    output logic [7:0] dropped,                      // Turns dropped (saturating)
+    output logic drop                                // A turn is dropped this cycle
+);
+
+    localparam PTR_BITS = (DEPTH > 1) ? $clog2(DEPTH) : 1;
+
+    direction_t dirs [0:DEPTH-1];
+    logic [STAMP_BITS-1:0] stamps [0:DEPTH-1];
+    logic [PTR_BITS-1:0] rd_ptr, wr_ptr;
+    logic [PTR_BITS:0] count;
+
+    assign empty = (count == 0);
+    assign turn_dir = dirs[rd_ptr];
+    assign turn_stamp = stamps[rd_ptr];
+
+    function automatic logic [PTR_BITS-1:0] next_ptr(input logic [PTR_BITS-1:0] p);
+        return (p == PTR_BITS'(DEPTH - 1)) ? '0 : p + 1'b1;
+    endfunction
+
+    // Direction a new turn is rotated from, and the turn itself
+    direction_t last_dir, new_dir;
+    logic push, accept;
+
+    always_comb begin
+        last_dir = empty ? curr_direction : dirs[(wr_ptr == 0) ? PTR_BITS'(DEPTH - 1) : wr_ptr - 1'b1];
+
+        // Directions are numbered clockwise, so a rotation is +/-1
+        new_dir = rotate_cw ? direction_t'(last_dir + 2'd1) : direction_t'(last_dir - 2'd1);
+
+        push = rotate_cw || rotate_ccw;
+        accept = push && (count < (PTR_BITS+1)'(DEPTH) || pop);
+    end
+
+    assign drop = push && !accept && !clear;
+
+    always_ff @(posedge clk or negedge reset_n) begin
+        if (~reset_n) begin
+            for (int i = 0; i < DEPTH; i++) begin
+                dirs[i] <= DIR_RIGHT;
+                stamps[i] <= '0;
+            end
+            rd_ptr <= 0;
+            wr_ptr <= 0;
+            count <= 0;
+            dropped <= 0;
+        end else if (clear) begin
+            rd_ptr <= 0;
+            wr_ptr <= 0;
+            count <= 0;
+        end else begin
+            if (accept) begin
+                dirs[wr_ptr] <= new_dir;
+                stamps[wr_ptr] <= now;
+                wr_ptr <= next_ptr(wr_ptr);
+            end else if (push && dropped != 8'hFF) begin
+                dropped <= dropped + 1'b1;
+            end
+
+            if (pop && !empty)
+                rd_ptr <= next_ptr(rd_ptr);
+
+            count <= count + (PTR_BITS+1)'(accept) - (PTR_BITS+1)'(pop && !empty);
+        end
+    end
+
+endmodule
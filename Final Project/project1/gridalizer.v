@@ -1,30 +1,34 @@
 module gridalizer(
-    output reg [5:0] grid_x,
-    output reg [4:0] grid_y,
+    output reg [6:0] grid_x,
+    output reg [5:0] grid_y,
     input [10:0] pos_h,
     input [9:0] pos_v,
     input clk
 );
 
-    // Assuming grid size of 40x30 (adjust as needed)
+    // 80x60 grid of 8x8 pixel cells over the 640x480 picture
     parameter GRID_WIDTH = 80;
     parameter GRID_HEIGHT = 60;
-    parameter PIXELS_PER_GRID_X = 8; // 640 / 40
-    parameter PIXELS_PER_GRID_Y = 8; // 480 / 30
+    parameter PIXELS_PER_GRID_X = 8; // 640 / 80
+    parameter PIXELS_PER_GRID_Y = 8; // 480 / 60
+    parameter H_START = 144;         // First visible h_cnt (sync + back porch)
+    parameter V_START = 35;          // First visible v_cnt (sync + back porch)
+
+    wire [10:0] pix_h = pos_h - H_START;
+    wire [9:0] pix_v = pos_v - V_START;
 
     always @(posedge clk)
     begin
-        if (pos_h < (GRID_WIDTH * PIXELS_PER_GRID_X))
-            grid_x <= pos_h / PIXELS_PER_GRID_X;
+        if (pos_h >= H_START && pix_h < (GRID_WIDTH * PIXELS_PER_GRID_X))
+            grid_x <= pix_h / PIXELS_PER_GRID_X;
         else
             grid_x <= GRID_WIDTH - 1;
 
-        if (pos_v < (GRID_HEIGHT * PIXELS_PER_GRID_Y))
-            grid_y <= pos_v / PIXELS_PER_GRID_Y;
+        if (pos_v >= V_START && pix_v < (GRID_HEIGHT * PIXELS_PER_GRID_Y))
+            grid_y <= pix_v / PIXELS_PER_GRID_Y;
         else
             grid_y <= GRID_HEIGHT - 1;
     end
 
 endmodule
 
-
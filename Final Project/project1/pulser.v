@@ -1,7 +1,13 @@
-module pulser(
+// One-cycle move pulse on clk, used as a clock enable by the snake logic;
+// the period shortens as the snake grows. SIM_SPEEDUP divides the periods
+// so a simulation moves the snake in a few hundred clocks.
+module pulser #(
+    parameter LEN_BITS = 13,
+    parameter SIM_SPEEDUP = 1
+)(
     output reg p,
     input clk,
-    input [3:0] len,
+    input [LEN_BITS-1:0] len,
     input reset
 );
 
@@ -34,11 +40,11 @@ module pulser(
     always @(*)
     begin
         if (len < 5)
-            PERIOD = 18000000; // Slow
+            PERIOD = 18000000 / SIM_SPEEDUP; // Slow
         else if (len < 8)
-            PERIOD = 12000000; // Medium
+            PERIOD = 12000000 / SIM_SPEEDUP; // Medium
         else
-            PERIOD = 8000000;  // Fast
+            PERIOD = 8000000 / SIM_SPEEDUP;  // Fast
     end
 
 endmodule
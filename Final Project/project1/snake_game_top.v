@@ -13,6 +13,10 @@ module snake_game_top(
 wire reset_n = SW[0];
 wire reset = ~reset_n;
 
+// Divides every real-time constant (debounce sample rate, move period)
+// for simulation; leave at 1 for the board
+parameter SIM_SPEEDUP = 1;
+
 // Generate 25 MHz VGA clock using PLL
 wire VGA_CLK;
 wire locked;
@@ -63,26 +67,23 @@ apple_generator apple_gen_inst(
     .y_pos(appleY)
 );
 
-// User input handling (debounced)
-wire clockwise_input_raw = ~KEY[0]; // Use KEY[1] for user input
+// User input handling (debounced, common/debouncer.sv): one pulse per
+// press of KEY[0] (clockwise) or KEY[1] (counterclockwise)
 wire clockwise_input;
-
-wire counterclockwise_input_raw = ~KEY[1]; // Use KEY[1] for user input
 wire counterclockwise_input;
 
-
-debounce_and_oneshot debounce_inst_cw(
-    .debounce_out(clockwise_input),
-    .debounce_in(clockwise_input_raw),
-    .clk_50MHz(MAX10_CLK1_50),
-    .rst(reset)
-);
-debounce_and_oneshot debounce_inst_ccw(
-    .debounce_out(counterclockwise_input),
-    .debounce_in(counterclockwise_input_raw),
-    .clk_50MHz(MAX10_CLK1_50),
-    .rst(reset)
+debouncer #(
+    .N(2),
+    .SIM_SPEEDUP(SIM_SPEEDUP)
+) debounce_keys(
+    .clk(MAX10_CLK1_50),
+    .rst(reset),
+    .in(~KEY),
+    .level(),
+    .rise({counterclockwise_input, clockwise_input}),
+    .fall()
 );
+
 // Direction handling
 wire [1:0] direction;
 
@@ -94,65 +95,200 @@ directionizer dir_inst(
     .reset(reset)
 );
 
+// Snake size: up to the whole 80x60 grid
+parameter GRID_WIDTH = 80;
+parameter GRID_HEIGHT = 60;
+parameter MAX_LEN = GRID_WIDTH * GRID_HEIGHT;
+localparam BODY_BITS = $clog2(MAX_LEN);     // Ring buffer address
+localparam LEN_BITS = $clog2(MAX_LEN + 1);
+
 // Generate movement pulses based on snake length
 wire move_pulse;
-reg [3:0] snake_length;
+reg [LEN_BITS-1:0] snake_length;
 
-pulser pulser_inst(
+pulser #(
+    .LEN_BITS(LEN_BITS),
+    .SIM_SPEEDUP(SIM_SPEEDUP)
+) pulser_inst(
     .p(move_pulse),
     .clk(MAX10_CLK1_50),
     .len(snake_length),
     .reset(reset)
 );
 
-// Snake positions
-reg [10:0] snake[0:9]; // 32 snake segments ; changed to 10 for now
+// Snake body: ring buffer of {y, x} positions in block RAM, head at
+// head_ptr, tail at tail_ptr. The tail is read back continuously so it is
+// ready when the next move retires it.
+reg [BODY_BITS-1:0] head_ptr;
+reg [BODY_BITS-1:0] tail_ptr;
+reg [6:0] head_x;
+reg [5:0] head_y;
+reg body_wr_en;
+reg [BODY_BITS-1:0] body_wr_addr;
+reg [12:0] body_wr_data;
+wire [12:0] tail_pos;
+
+snake_ram #(
+    .DATA_WIDTH(13),
+    .ADDR_WIDTH(BODY_BITS)
+) body_ram(
+    .wr_clk(MAX10_CLK1_50),
+    .wr_en(body_wr_en),
+    .wr_addr(body_wr_addr),
+    .wr_data(body_wr_data),
+    .rd_clk(MAX10_CLK1_50),
+    .rd_addr(tail_ptr),
+    .rd_data(tail_pos)
+);
+
+// Occupancy bitmap: one bit per grid cell, {y, x}, written here and read
+// by the renderer on the VGA clock
+reg map_wr_en;
+reg [12:0] map_wr_addr;
+reg map_wr_data;
+wire [12:0] map_rd_addr;
+wire map_rd_data;
+
+snake_ram #(
+    .DATA_WIDTH(1),
+    .ADDR_WIDTH(13)
+) map_ram(
+    .wr_clk(MAX10_CLK1_50),
+    .wr_en(map_wr_en),
+    .wr_addr(map_wr_addr),
+    .wr_data(map_wr_data),
+    .rd_clk(VGA_CLK),
+    .rd_addr(map_rd_addr),
+    .rd_data(map_rd_data)
+);
 
-integer i;
+// Snake movement logic, on the 50 MHz clock with move_pulse as the enable.
+// After reset the bitmap is cleared one cell per cycle and the head laid
+// down. Each move then takes two cycles: the new head goes into the ring
+// buffer and the old tail is cleared from the bitmap (unless the snake
+// grows), then the new head is set in the bitmap.
+localparam S_CLEAR = 2'd0;
+localparam S_INIT = 2'd1;
+localparam S_RUN = 2'd2;
+localparam S_HEAD = 2'd3;
+localparam [12:0] LAST_CELL = (GRID_HEIGHT - 1) * 128 + GRID_WIDTH - 1;
 
-// Snake movement logic
-always @(posedge move_pulse or posedge reset)
+reg [1:0] state;
+reg [12:0] clear_addr;
+reg [6:0] next_x;
+reg [5:0] next_y;
+reg [6:0] CurAppleX;
+reg [5:0] CurAppleY;
+wire grows = head_x == CurAppleX && head_y == CurAppleY && snake_length < MAX_LEN;
+
+// Next head position, wrapping at the grid's edges
+always @(*)
+begin
+    next_x = head_x;
+    next_y = head_y;
+    case (direction)
+        2'd0: next_y = (head_y == 0) ? GRID_HEIGHT - 1 : head_y - 1;  // Up
+        2'd1: next_x = (head_x == GRID_WIDTH - 1) ? 0 : head_x + 1;   // Right
+        2'd2: next_y = (head_y == GRID_HEIGHT - 1) ? 0 : head_y + 1;  // Down
+        2'd3: next_x = (head_x == 0) ? GRID_WIDTH - 1 : head_x - 1;   // Left
+    endcase
+end
+
+always @(*)
+begin
+    body_wr_en = 0;
+    body_wr_addr = head_ptr + 1'b1;
+    body_wr_data = {next_y, next_x};
+    map_wr_en = 0;
+    map_wr_addr = {head_y, head_x};
+    map_wr_data = 1;
+    case (state)
+        S_CLEAR:
+        begin
+            map_wr_en = 1;
+            map_wr_addr = clear_addr;
+            map_wr_data = 0;
+        end
+        S_INIT:
+        begin
+            body_wr_en = 1;
+            body_wr_addr = head_ptr;
+            body_wr_data = {head_y, head_x};
+            map_wr_en = 1;
+        end
+        S_RUN:
+        begin
+            if (move_pulse)
+            begin
+                body_wr_en = 1;
+                map_wr_en = !grows;
+                map_wr_addr = tail_pos;
+                map_wr_data = 0;
+            end
+        end
+        S_HEAD:
+            map_wr_en = 1;
+    endcase
+end
+
+always @(posedge MAX10_CLK1_50 or posedge reset)
 begin
     if (reset)
     begin
-        // Initialize snake
-        snake_length <= 4'd1; //0001
-        snake[0] <= {5'd15, 6'd20}; // Initial position at grid_x=20, grid_y=15
-        for (i = 1; i < 10; i = i + 1)
-            snake[i] <= 11'd0;
+        // Initialize snake at grid_x=20, grid_y=15
+        state <= S_CLEAR;
+        clear_addr <= 0;
+        snake_length <= 1;
+        head_x <= 7'd20;
+        head_y <= 6'd15;
+        head_ptr <= 0;
+        tail_ptr <= 0;
+        CurAppleX <= 7'd10;
+        CurAppleY <= 6'd10;
     end
     else
     begin
-        // Shift snake segments
-        for (i = 9; i > 0; i = i - 1)
-		  begin
-				if (i <= snake_length)
-					snake[i] <= snake[i - 1];
-				end
-
-        // Move snake head based on direction
-        case (direction)
-            2'd0: snake[0][10:6] <= snake[0][10:6] - 1; // Up
-            2'd1: snake[0][5:0]  <= snake[0][5:0] + 1;  // Right
-            2'd2: snake[0][10:6] <= snake[0][10:6] + 1; // Down
-            2'd3: snake[0][5:0]  <= snake[0][5:0] - 1;  // Left
-        endcase
+        case (state)
+            S_CLEAR:
+            begin
+                clear_addr <= clear_addr + 1'b1;
+                if (clear_addr == LAST_CELL)
+                    state <= S_INIT;
+            end
+            S_INIT:
+                state <= S_RUN;
+            S_RUN:
+            begin
+                if (move_pulse)
+                begin
+                    head_x <= next_x;
+                    head_y <= next_y;
+                    head_ptr <= head_ptr + 1'b1;
 
-        // Collision with apple
-        if (snake[0][5:0] == appleX && snake[0][10:6] == appleY)
-        begin
-            if (snake_length < 9)
-                snake_length <= snake_length + 1;
-        end
+                    // Collision with apple: grow and take a new apple
+                    if (grows)
+                    begin
+                        snake_length <= snake_length + 1'b1;
+                        CurAppleX <= appleX;
+                        CurAppleY <= appleY;
+                    end
+                    else
+                        tail_ptr <= tail_ptr + 1'b1;
+
+                    state <= S_HEAD;
+                end
+            end
+            S_HEAD:
+                state <= S_RUN;
+        endcase
     end
 end
 
-// VGA rectangle rendering
+// VGA rectangle rendering. Head and apple positions change only on moves
+// and are sampled by the VGA clock domain as they are.
 wire red;
 wire green;
 wire blue;
-wire [5:0] CurAppleX;
-wire [4:0] CurAppleY;
 
 vga_rectangle vga_rect_inst(
     .red(red),
@@ -162,26 +298,27 @@ vga_rectangle vga_rect_inst(
     .grid_y(grid_y),
     .blank(~blank_n),
     .clk(VGA_CLK),
-    .appleX(appleX),
-    .appleY(appleY),
-    .snake0(snake[0]),
-    .snake1(snake[1]),
-    .snake2(snake[2]),
-    .snake3(snake[3]),
-    .snake4(snake[4]),
-    .snake5(snake[5]),
-    .snake6(snake[6]),
-    .snake7(snake[7]),
-    .snake8(snake[8]),
-    .snake9(snake[9]),
-    .reset(reset),
-    .CurAppleX(CurAppleX),
-    .CurAppleY(CurAppleY)
+    .appleX(CurAppleX),
+    .appleY(CurAppleY),
+    .headX(head_x),
+    .headY(head_y),
+    .body_addr(map_rd_addr),
+    .body_bit(map_rd_data)
 );
 
+// Sync delayed to match the grid lookup and the renderer's two stages
+reg [1:0] hs_d;
+reg [1:0] vs_d;
+
+always @(posedge VGA_CLK)
+begin
+    hs_d <= {hs_d[0], HS};
+    vs_d <= {vs_d[0], VS};
+end
+
 // Assign VGA outputs
-assign VGA_HS = HS;
-assign VGA_VS = VS;
+assign VGA_HS = hs_d[1];
+assign VGA_VS = vs_d[1];
 assign VGA_R = {4{red}};
 assign VGA_G = {4{green}};
 assign VGA_B = {4{blue}};
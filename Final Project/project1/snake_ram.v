@@ -0,0 +1,29 @@
+// Simple dual-port block RAM: one write port, one registered read port,
+// each on its own clock. Read data appears one rd_clk cycle after rd_addr.
+module snake_ram #(
+    parameter DATA_WIDTH = 13,
+    parameter ADDR_WIDTH = 13
+)(
+    input wr_clk,
+    input wr_en,
+    input [ADDR_WIDTH-1:0] wr_addr,
+    input [DATA_WIDTH-1:0] wr_data,
+    input rd_clk,
+    input [ADDR_WIDTH-1:0] rd_addr,
+    output reg [DATA_WIDTH-1:0] rd_data
+);
+
+    (* ramstyle = "M9K" *) reg [DATA_WIDTH-1:0] mem [0:(1<<ADDR_WIDTH)-1];
+
+    always @(posedge wr_clk)
+    begin
+        if (wr_en)
+            mem[wr_addr] <= wr_data;
+    end
+
+    always @(posedge rd_clk)
+    begin
+        rd_data <= mem[rd_addr];
+    end
+
+endmodule
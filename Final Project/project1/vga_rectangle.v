@@ -1,3 +1,10 @@
+// Pixel colour for the grid cell under the beam.
+//
+// The snake's body is looked up in the occupancy bitmap (one bit per grid
+// cell, in block RAM, kept by snake_game_top) instead of being compared
+// against every segment, so the cost does not grow with the snake:
+//   stage 1 - bitmap read at {grid_y, grid_x}; position and blank delayed
+//   stage 2 - colour register
 module vga_rectangle(
     output reg red,
     output reg green,
@@ -6,58 +13,32 @@ module vga_rectangle(
     input [5:0] grid_y,
     input blank,
     input clk,
-    input [5:0] appleX,
-    input [4:0] appleY,
-    input [10:0] snake0,
-    input [10:0] snake1,
-    input [10:0] snake2,
-    input [10:0] snake3,
-    input [10:0] snake4,
-    input [10:0] snake5,
-    input [10:0] snake6,
-    input [10:0] snake7,
-    input [10:0] snake8,
-    input [10:0] snake9,
-    input reset,
-    output reg [5:0] CurAppleX,
-    output reg [4:0] CurAppleY
+    input [6:0] appleX,        // Current apple
+    input [5:0] appleY,
+    input [6:0] headX,         // Snake head
+    input [5:0] headY,
+    output [12:0] body_addr,   // Bitmap read address, {grid_y, grid_x}
+    input body_bit             // Bitmap data, one clock after body_addr
 );
 
-    reg [5:0] snake_x [0:9];
-    reg [4:0] snake_y [0:9];
-    integer i;
+    // Stage 1: bitmap lookup
+    reg [6:0] grid_x_d;
+    reg [5:0] grid_y_d;
+    reg blank_d;
 
-    // Assign snake positions to arrays for easier handling
-    always @(*)
-    begin
-        snake_x[0] = snake0[5:0];
-        snake_y[0] = snake0[10:6];
-        snake_x[1] = snake1[5:0];
-        snake_y[1] = snake1[10:6];
-		  snake_x[2] = snake1[5:0];
-        snake_y[2] = snake1[10:6];
-		  snake_x[3] = snake1[5:0];
-        snake_y[3] = snake1[10:6];
-		  snake_x[4] = snake1[5:0];
-        snake_y[4] = snake1[10:6];
-		  snake_x[5] = snake1[5:0];
-        snake_y[5] = snake1[10:6];
-		  snake_x[6] = snake1[5:0];
-        snake_y[6] = snake1[10:6];
-		  snake_x[7] = snake1[5:0];
-        snake_y[7] = snake1[10:6];
-		  snake_x[8] = snake1[5:0];
-        snake_y[8] = snake1[10:6];
-		  snake_x[9] = snake1[5:0];
-        snake_y[9] = snake1[10:6];
-        // ... Repeat for all snake segments up to snake31
+    assign body_addr = {grid_y, grid_x};
 
+    always @(posedge clk)
+    begin
+        grid_x_d <= grid_x;
+        grid_y_d <= grid_y;
+        blank_d <= blank;
     end
 
-    // Render the grid
+    // Stage 2: render the grid
     always @(posedge clk)
     begin
-        if (blank)
+        if (blank_d)
         begin
             red <= 0;
             green <= 0;
@@ -66,58 +47,40 @@ module vga_rectangle(
         else
         begin
             // Draw walls (blue)
-            if (grid_x == 5 || grid_y == 6)
+            if (grid_x_d == 5 || grid_y_d == 6)
             begin
                 red <= 0;
                 green <= 0;
                 blue <= 1;
             end
             // Draw apple (red)
-            else if (grid_x == CurAppleX && grid_y == CurAppleY)
+            else if (grid_x_d == appleX && grid_y_d == appleY)
             begin
                 red <= 1;
                 green <= 0;
                 blue <= 0;
             end
             // Draw snake head (green)
-            else if (grid_x == snake_x[0] && grid_y == snake_y[0])
+            else if (grid_x_d == headX && grid_y_d == headY)
             begin
                 red <= 0;
                 green <= 1;
                 blue <= 0;
             end
             // Draw snake body (cyan)
+            else if (body_bit)
+            begin
+                red <= 0;
+                green <= 1;
+                blue <= 1;
+            end
             else
             begin
                 red <= 0;
                 green <= 0;
                 blue <= 0;
-                for (i = 1; i < 10; i = i + 1)
-                begin
-                    if (snake_x[i] == grid_x && snake_y[i] == grid_y)
-                    begin
-                        red <= 0;
-                        green <= 1;
-                        blue <= 1;
-                    end
-                end
             end
         end
     end
 
-    // Update apple position when eaten
-    always @(posedge clk or posedge reset)
-    begin
-        if (reset)
-        begin
-            CurAppleX <= appleX;
-            CurAppleY <= appleY;
-        end
-        else if (snake_x[0] == CurAppleX && snake_y[0] == CurAppleY)
-        begin
-            CurAppleX <= appleX;
-            CurAppleY <= appleY;
-        end
-    end
-
 endmodule
@@ -1,4 +1,6 @@
-module fsm_multiplier (
+module fsm_multiplier #(
+    parameter SIM_SPEEDUP = 1 // Simulation only: divides the debounce time
+) (
     input MAX10_CLK1_50,
     input [1:0] KEY,          // KEY[0]: Start/multiply (active-low), KEY[1]: Mode cycle (active-low)
     input [9:0] SW,
@@ -30,27 +32,34 @@ module fsm_multiplier (
     wire btn_pressed, btn1_pressed;
     reg [1:0] mode_counter, next_mode_counter;
 
-    // Debounce KEY[0] and KEY[1]
+    // Debounce KEY[0] and KEY[1] (common/debouncer.sv)
     wire debounced_key0, debounced_key1;
-    debounce debounce_key0 (
+    debouncer #(
+        .N(2),
+        .SIM_SPEEDUP(SIM_SPEEDUP)
+    ) debounce_keys (
         .clk(MAX10_CLK1_50),
-        .btn_in(~KEY[0]),
-        .btn_out(debounced_key0)
-    );
-    debounce debounce_key1 (
-        .clk(MAX10_CLK1_50),
-        .btn_in(~KEY[1]),
-        .btn_out(debounced_key1)
+        .rst(1'b0),
+        .in(~KEY),
+        .level({debounced_key1, debounced_key0}),
+        .rise(),
+        .fall()
     );
 
     // BCD converter
     wire [3:0] bcd1, bcd10, bcd100, bcd1000;
-    bcd_converter A (
-        .binary(product),
-        .bcd1(bcd1),
-        .bcd10(bcd10),
-        .bcd100(bcd100),
-        .bcd1000(bcd1000)
+    // (common/bin2bcd.sv, iterative: a fresh conversion every 17 clocks)
+    bin2bcd #(
+        .WIDTH(16),
+        .DIGITS(4)
+    ) A (
+        .clk(MAX10_CLK1_50),
+        .reset_n(KEY[1]),
+        .start(1'b1),
+        .bin(product),
+        .busy(),
+        .valid(),
+        .bcd({bcd1000, bcd100, bcd10, bcd1})
     );
 
     // Combinational next-state logic
@@ -212,64 +221,3 @@ module fsm_multiplier (
         endcase
     endfunction
 endmodule
-	 
-// Debounce module (corrected for active-low input)
-
-module debounce (
-    input clk,
-    input btn_in, // Now expects active-high input (after inversion)
-    output reg btn_out
-);
-    reg [15:0] counter;
-    reg [3:0] sync_reg;
-
-    always @(posedge clk) begin
-        sync_reg <= {sync_reg[2:0], btn_in}; // Synchronize input
-        if (sync_reg[3] ^ sync_reg[2]) // Reset counter on input change
-            counter <= 0;
-        else if (counter < 20'hFFFFF) // ~1ms debounce at 50MHz
-            counter <= counter + 1;
-        else
-            btn_out <= sync_reg[3]; // Stable output
-    end
-endmodule
-
-// BCD converter module (Double Dabble algorithm)
-
-module bcd_converter (
-    input [15:0] binary,
-    output reg [3:0] bcd1, bcd10, bcd100, bcd1000
-);
-    integer i;
-    reg [3:0] thousands, hundreds, tens, ones;
-
-    always @(binary) begin
-        thousands = 4'b0;
-        hundreds = 4'b0;
-        tens = 4'b0;
-        ones = 4'b0;
-
-        for (i = 15; i >= 0; i = i - 1) begin
-            // Add 3 if >=5 for each digit
-            if (thousands >= 5) thousands = thousands + 3;
-            if (hundreds >= 5) hundreds = hundreds + 3;
-            if (tens >= 5) tens = tens + 3;
-            if (ones >= 5) ones = ones + 3;
-
-            // Shift left
-            thousands = thousands << 1;
-            thousands[0] = hundreds[3];
-            hundreds = hundreds << 1;
-            hundreds[0] = tens[3];
-            tens = tens << 1;
-            tens[0] = ones[3];
-            ones = ones << 1;
-            ones[0] = binary[i];
-        end
-
-        bcd1000 = thousands;
-        bcd100 = hundreds;
-        bcd10 = tens;
-        bcd1 = ones;
-    end
-endmodule
\ No newline at end of file
@@ -29,12 +29,18 @@ module fsm_multiplier_sim (
 
     // BCD converter
     wire [3:0] bcd1, bcd10, bcd100, bcd1000;
-    bcd_converter A (
-        .binary(product),
-        .bcd1(bcd1),
-        .bcd10(bcd10),
-        .bcd100(bcd100),
-        .bcd1000(bcd1000)
+    // (common/bin2bcd.sv, iterative: a fresh conversion every 17 clocks)
+    bin2bcd #(
+        .WIDTH(16),
+        .DIGITS(4)
+    ) A (
+        .clk(MAX10_CLK1_50),
+        .reset_n(KEY[1]),
+        .start(1'b1),
+        .bin(product),
+        .busy(),
+        .valid(),
+        .bcd({bcd1000, bcd100, bcd10, bcd1})
     );
 
     // Combinational next-state logic
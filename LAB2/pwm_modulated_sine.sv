@@ -1,14 +1,53 @@
 //=============================================================================
-// pwm_modulated_sine: PWM modulated sine generator with integrated Mealy FSM,
-// synchronized reset from SW[0], and button debouncing for KEY[0] and KEY[1]
-// ARDUINO PIN 0: fixed 50% duty cycle PWM
-// ARDUINO PIN 1: Modulated PWM
+// pwm_modulated_sine: CHANNELS-phase DDS sine generator with PWM or
+// sigma-delta outputs, integrated Mealy FSM, synchronized reset from SW[0],
+// and button debouncing for KEY[0] and KEY[1]
+// ARDUINO PIN 0: 50% duty cycle square wave, in step with channel 0
+// ARDUINO PIN c+1: channel c's sine, PWM (SW[1] down) or sigma-delta (SW[1] up)
+// SW[3:2]: key step, 00 100 Hz, 01 10 Hz, 10 1 Hz, 11 0.1 Hz (on LEDR[3:2])
+//
+// A 32-bit phase accumulator per channel advances by a tuning word every
+// clock; its top bits index a quarter-wave sine LUT, so the sine frequency
+// is
+//   freq = tuning_word * CLOCK_FREQ / 2**32
+// with a resolution of CLOCK_FREQ / 2**32 (0.012 Hz). freq counts tenths
+// of a hertz from 100 Hz to 10 kHz; the keys move it by the step SW[3:2]
+// selects, so the coarse steps cross the range quickly and the fine ones
+// reach any 0.1 Hz in it. The PWM runs at a fixed period of 2**PWM_BITS
+// clocks; each period's duty is the sine sample at its start. Key presses
+// retune at the next period boundary without touching the accumulators, so
+// the sines stay phase continuous.
+//
+// Each channel has its own tuning word, phase offset and amplitude, set by
+// the per-channel parameters: channel c runs at FREQ_MULT[c] times the
+// selected frequency, offset by c * PHASE_STEP + PHASE_OFFSET[c] and
+// scaled by AMPLITUDE[c]. By default all run at the selected frequency,
+// evenly spread at full scale: 3 channels give 3-phase, and CHANNELS = 2
+// with PHASE_STEP = 2**30 gives I/Q. Harmonics above half the PWM rate
+// alias on the PWM outputs; the sigma-delta outputs carry them. The
+// channels share one LUT (sine_bank.sv).
+//
+// The sigma-delta modulators take a new sine sample every CHANNELS clocks
+// and output one bit per clock, of order SD_ORDER (1 or 2). Their
+// quantization noise rises with frequency (20 dB/decade per order), so
+// after the same RC filter the audio band is far quieter than the PWM,
+// whose resolution is fixed at PWM_BITS.
 //=============================================================================
-module pwm_modulated_sine (
+module pwm_modulated_sine #(
+    parameter PWM_BITS = 10,   // PWM period 2**PWM_BITS clocks (48.8 kHz)
+    parameter LUT_BITS = 6,    // Quarter-wave sine LUT of 2**LUT_BITS steps
+    parameter SD_ORDER = 2,    // Sigma-delta modulator order, 1 or 2
+    parameter CHANNELS = 1,    // Sine outputs, on ARDUINO_IO[CHANNELS:1]
+    parameter [31:0] PHASE_STEP = 32'(33'h1_0000_0000 / CHANNELS), // Between channels, turn * 2**32
+    parameter [CHANNELS-1:0][7:0] FREQ_MULT = {CHANNELS{8'd1}}, // Per channel, times the selected frequency
+    parameter [CHANNELS-1:0][31:0] PHASE_OFFSET = '0, // Per channel, added to c * PHASE_STEP
+    parameter [CHANNELS-1:0][15:0] AMPLITUDE = {CHANNELS{16'hFFFF}}, // Per channel, 16'hFFFF ~ 1
+    parameter SIM_SPEEDUP = 1  // Simulation only: divides the debounce time
+) (
     input logic MAX10_CLK1_50, // 50MHz clock
-    input logic [1:0] SW,      // Board switches (SW[0] used for reset)
+    input logic [3:0] SW,      // SW[0]: run (low resets), SW[1]: sigma-delta output, SW[3:2]: key step
     input logic [1:0] KEY,     // Push buttons for frequency control
-    output logic ARDUINO_IO[1:0], // PWM outputs
+    output logic ARDUINO_IO[CHANNELS:0], // Square wave, then PWM/sigma-delta outputs
     output logic [9:0] LEDR    // LED dimming / status outputs
 );
     //-------------------------------------------------------------------------
@@ -17,6 +56,7 @@ module pwm_modulated_sine (
     // synchronizer to generate rst_sync.
     //-------------------------------------------------------------------------
     logic rst_async;
+    logic rst_sync;
     assign rst_async = ~SW[0]; // Active when SW[0] is low
     reg rst_ff1, rst_ff2;
     always_ff @(posedge MAX10_CLK1_50 or posedge rst_async) begin
@@ -35,95 +75,137 @@ module pwm_modulated_sine (
     // Parameters
     //-------------------------------------------------------------------------
     localparam CLOCK_FREQ = 50_000_000;
-    localparam BASE_FREQ = 1000;       // Initial frequency = 1 kHz
-    localparam SAMPLE_COUNT = 200;     // 200-point sine LUT
-    localparam MIN_FREQ = 100;         // Minimum frequency = 100 Hz
-    localparam MAX_FREQ = 10000;       // Maximum frequency = 10 kHz
-    localparam STEP_FREQ = 100;        // Step up or down frequency change 100 Hz
+    localparam FREQ_SCALE = 10;        // freq counts 0.1 Hz
+    localparam BASE_FREQ = 1000 * FREQ_SCALE;  // Initial frequency = 1 kHz
+    localparam MIN_FREQ = 100 * FREQ_SCALE;    // Minimum frequency = 100 Hz
+    localparam MAX_FREQ = 10000 * FREQ_SCALE;  // Maximum frequency = 10 kHz
+    localparam FREQ_BITS = $clog2(MAX_FREQ + 1);
+    
+    // Tuning word per 0.1 Hz, 2**32 / (CLOCK_FREQ * FREQ_SCALE), in Q16
+    // (elaboration only; the hardware multiplies by this constant, it never
+    // divides)
+    localparam longint CLOCK_FREQ_SCALED = longint'(CLOCK_FREQ * FREQ_SCALE);
+    localparam longint TW_PER_STEP = ((64'd1 << 48) + CLOCK_FREQ_SCALED / 2) / CLOCK_FREQ_SCALED;
+    
+    // Duty cycle swing: the Q15 sine scaled to +/- a quarter period, 25%-75%
+    localparam SINE_SHIFT = 17 - PWM_BITS;
+    localparam logic [PWM_BITS-1:0] HALF_PERIOD = PWM_BITS'(1) << (PWM_BITS - 1);
     
     //-------------------------------------------------------------------------
     // Debounced push-button pulses for frequency control.
     // KEY[0] increases frequency; KEY[1] decreases frequency.
+    // (common/debouncer.sv; KEY is active low, so the pulse is on release)
     //-------------------------------------------------------------------------
     logic key0_pulse, key1_pulse;
-    button_debounce deb0 (
+    debouncer #(
+        .N(2),
+        .SIM_SPEEDUP(SIM_SPEEDUP)
+    ) deb (
         .clk(MAX10_CLK1_50),
         .rst(rst_sync),
-        .button(KEY[0]),
-        .pulse(key0_pulse)
+        .in(KEY),
+        .level(),
+        .rise({key1_pulse, key0_pulse}),
+        .fall()
     );
-    button_debounce deb1 (
+    
+    //-------------------------------------------------------------------------
+    // Frequency, DDS and PWM registers
+    //-------------------------------------------------------------------------
+    logic [31:0] freq;                 // Current frequency in 0.1 Hz
+    logic [31:0] tuning_target;        // Tuning word for freq
+    logic [31:0] tuning_word;          // Tuning word in use
+    logic [PWM_BITS-1:0] counter;      // PWM period counter
+    logic [CHANNELS-1:0][PWM_BITS-1:0] d_compare; // Duty cycle compare values
+    logic [CHANNELS-1:0][15:0] sine;   // Q15 sine per channel
+    logic [CHANNELS-1:0] square;       // Square wave per channel
+    
+    //-------------------------------------------------------------------------
+    // Tuning word for the selected frequency. Registered, and only taken
+    // into use at a period boundary (S_UPDATE).
+    //-------------------------------------------------------------------------
+    always_ff @(posedge MAX10_CLK1_50) begin
+        tuning_target <= 32'((64'(freq[FREQ_BITS-1:0]) * TW_PER_STEP + 64'h8000) >> 16);
+    end
+    
+    //-------------------------------------------------------------------------
+    // The channels' sines (sine_bank.sv). Channel c's tuning word is
+    // FREQ_MULT[c] times the one in use, registered so the constant
+    // multiplies stay off the accumulators' path; all channels still
+    // retune on the same clock.
+    //-------------------------------------------------------------------------
+    logic [CHANNELS-1:0][31:0] bank_tuning;
+    logic [CHANNELS-1:0][31:0] bank_offset;
+    logic [CHANNELS-1:0][15:0] bank_amplitude;
+    
+    always_ff @(posedge MAX10_CLK1_50) begin
+        for (int c = 0; c < CHANNELS; c++)
+            bank_tuning[c] <= tuning_word * 32'(FREQ_MULT[c]);
+    end
+    
+    always_comb begin
+        for (int c = 0; c < CHANNELS; c++) begin
+            bank_offset[c] = 32'(c * PHASE_STEP) + PHASE_OFFSET[c];
+            bank_amplitude[c] = AMPLITUDE[c];
+        end
+    end
+    
+    sine_bank #(
+        .CHANNELS(CHANNELS),
+        .LUT_BITS(LUT_BITS)
+    ) bank (
         .clk(MAX10_CLK1_50),
         .rst(rst_sync),
-        .button(KEY[1]),
-        .pulse(key1_pulse)
+        .tuning_word(bank_tuning),
+        .phase_offset(bank_offset),
+        .amplitude(bank_amplitude),
+        .square(square),
+        .sine(sine),
+        .update()
     );
     
     //-------------------------------------------------------------------------
-    // Frequency and PWM control registers and variables
+    // Output mode from SW[1], synchronized
     //-------------------------------------------------------------------------
-    logic [31:0] freq;          // Current frequency in Hz
-    logic [31:0] counter;       // PWM period counter
-    logic [31:0] counter_max;   // Maximum counter value (PWM period)
-    logic [31:0] d0_compare;    // 50% duty cycle compare value
-    logic [31:0] d1_compare;    // Modulated duty cycle compare value
-    logic [15:0] phase;         // Phase index into sine LUT
-    logic signed [31:0] scaled; // Scaled sine value (for modulation)
-    logic [15:0] amplitude;     // Amplitude for modulation
-    
-    // python code to get the Sine LUT values below:
-    // import numpy as np
-    // SAMPLE_COUNT = 200
-    // n = np.arange(SAMPLE_COUNT)
-    // sine_values = np.sin(2 * np.pi * n / SAMPLE_COUNT)
-    // q15_lut = np.round(sine_values * 32767).astype(int)
-    // print("logic signed [15:0] sine_lut [0:SAMPLE_COUNT-1] = '{")
-    // print(" " + ",\n ".join(
-    // ", ".join(f"{val:6d}" for val in q15_lut[i:i+10])
-    // for i in range(0, SAMPLE_COUNT, 10)
-    // ))
-    // print("};")
+    logic sd_mode_ff, sd_mode;
+    always_ff @(posedge MAX10_CLK1_50) begin
+        sd_mode_ff <= SW[1];
+        sd_mode <= sd_mode_ff;
+    end
     
     //-------------------------------------------------------------------------
-    // Sine LUT (16 bit quantized format)
+    // Key step from SW[3:2], synchronized: 100, 10, 1 or 0.1 Hz
     //-------------------------------------------------------------------------
-    logic signed [15:0] sine_lut [0:SAMPLE_COUNT-1] = '{
-        0,    1029,    2057,    3084,    4107,    5126,    6140,    7148,    8149,    9142,
-        10126, 11099, 12062, 13013, 13952, 14876, 15786, 16680, 17557, 18418,
-        19260, 20083, 20886, 21669, 22431, 23170, 23886, 24579, 25247, 25891,
-        26509, 27101, 27666, 28204, 28714, 29196, 29648, 30072, 30466, 30830,
-        31163, 31466, 31738, 31978, 32187, 32364, 32509, 32622, 32702, 32751,
-        32767, 32751, 32702, 32622, 32509, 32364, 32187, 31978, 31738, 31466,
-        31163, 30830, 30466, 30072, 29648, 29196, 28714, 28204, 27666, 27101,
-        26509, 25891, 25247, 24579, 23886, 23170, 22431, 21669, 20886, 20083,
-        19260, 18418, 17557, 16680, 15786, 14876, 13952, 13013, 12062, 11099,
-        10126,  9142,  8149,  7148,  6140,  5126,  4107,  3084,  2057,  1029,
-            0, -1029, -2057, -3084, -4107, -5126, -6140, -7148, -8149, -9142,
-        -10126,-11099,-12062,-13013,-13952,-14876,-15786,-16680,-17557,-18418,
-        -19260,-20083,-20886,-21669,-22431,-23170,-23886,-24579,-25247,-25891,
-        -26509,-27101,-27666,-28204,-28714,-29196,-29648,-30072,-30466,-30830,
-        -31163,-31466,-31738,-31978,-32187,-32364,-32509,-32622,-32702,-32751,
-        -32767,-32751,-32702,-32622,-32509,-32364,-32187,-31978,-31738,-31466,
-        -31163,-30830,-30466,-30072,-29648,-29196,-28714,-28204,-27666,-27101,
-        -26509,-25891,-25247,-24579,-23886,-23170,-22431,-21669,-20886,-20083,
-        -19260,-18418,-17557,-16680,-15786,-14876,-13952,-13013,-12062,-11099,
-        -10126, -9142, -8149, -7148, -6140, -5126, -4107, -3084, -2057, -1029
-    };
+    logic [1:0] step_sel_ff, step_sel;
+    logic [31:0] step_freq;            // In 0.1 Hz
+    always_ff @(posedge MAX10_CLK1_50) begin
+        step_sel_ff <= SW[3:2];
+        step_sel <= step_sel_ff;
+    end
+    
+    always_comb begin
+        case (step_sel)
+            2'b00:   step_freq = 100 * FREQ_SCALE;
+            2'b01:   step_freq = 10 * FREQ_SCALE;
+            2'b10:   step_freq = 1 * FREQ_SCALE;
+            default: step_freq = 1;
+        endcase
+    end
     
     //-------------------------------------------------------------------------
-    // Compute counter_max, d0_compare, and amplitude.
+    // A sigma-delta modulator per channel (sigma_delta.sv)
     //-------------------------------------------------------------------------
-    always_ff @(posedge MAX10_CLK1_50) begin
-        if (rst_sync) begin
-            counter_max <= 0;
-            d0_compare <= 0;
-            amplitude <= 0;
-        end
-        else begin
-            counter_max <= (CLOCK_FREQ / freq) - 1;
-            d0_compare <= ((CLOCK_FREQ / freq)) >> 1;
-            amplitude <= ((CLOCK_FREQ / freq)) >> 2;
-        end
+    logic [CHANNELS-1:0] sd_bit;
+    
+    for (genvar c = 0; c < CHANNELS; c++) begin : gen_sd
+        sigma_delta #(
+            .ORDER(SD_ORDER)
+        ) sd (
+            .clk(MAX10_CLK1_50),
+            .rst(rst_sync),
+            .x(sine[c]),
+            .out(sd_bit[c])
+        );
     end
     
     //-------------------------------------------------------------------------
@@ -145,34 +227,46 @@ module pwm_modulated_sine (
     
     //-------------------------------------------------------------------------
     // Mealy FSM for PWM generation, sine modulation, and frequency control.
-    // We use combinational logic to immediately compute a new frequency if a
-    // pending key event is present.
+    // S_UPDATE is the first clock of every PWM period; key events wait for
+    // it, so the duty cycle and the tuning word only change between periods.
     //-------------------------------------------------------------------------
     typedef enum logic [1:0] {
         S_RESET,  // Initialize registers
         S_COUNT,  // Generate PWM signals
-        S_UPDATE  // Update modulation parameters (and frequency if needed)
+        S_UPDATE  // Start of a period: new duty cycle, frequency and tuning word
     } state_t;
     
     state_t current_state, next_state;
     logic [31:0] new_freq; // Combinationally computed new frequency
+    logic [CHANNELS-1:0] modulated; // ARDUINO_IO[CHANNELS:1] in S_COUNT and S_UPDATE
     
     // Combinational next-state and frequency-update logic (Mealy style)
     always_comb begin
         // Default: no frequency change.
         new_freq = freq;
         
-        // Use latched key events to update new_freq immediately.
-        if (pending_key0 && (freq < MAX_FREQ))
-            new_freq = freq + STEP_FREQ;
-        else if (pending_key1 && (freq > MIN_FREQ))
-            new_freq = freq - STEP_FREQ;
+        // Use latched key events to update new_freq, stopping at the limits.
+        if (pending_key0)
+            new_freq = (freq + step_freq > MAX_FREQ) ? MAX_FREQ : freq + step_freq;
+        else if (pending_key1)
+            new_freq = (freq < MIN_FREQ + step_freq) ? MIN_FREQ : freq - step_freq;
         
-        // Transition to S_UPDATE if a pending key event exists or the PWM period expires.
-        if ((pending_key0 || pending_key1) || (counter == counter_max))
+        // Transition to S_UPDATE when the PWM period wraps.
+        if (counter == '1)
             next_state = S_UPDATE;
         else
             next_state = S_COUNT;
+        
+        // Modulated output. In S_UPDATE counter is 0 and the new duty is at
+        // least 25%, so the PWM starts its period high.
+        for (int c = 0; c < CHANNELS; c++) begin
+            if (sd_mode)
+                modulated[c] = sd_bit[c];
+            else if (current_state == S_UPDATE)
+                modulated[c] = 1'b1;
+            else
+                modulated[c] = (counter < d_compare[c]);
+        end
     end
     
     // FSM state update (synchronous reset)
@@ -187,107 +281,47 @@ module pwm_modulated_sine (
     always_ff @(posedge MAX10_CLK1_50) begin
         if (rst_sync) begin
             counter <= 0;
-            phase <= 0;
             freq <= BASE_FREQ;
-            d1_compare <= ((CLOCK_FREQ / BASE_FREQ)) >> 1;
-            scaled <= 0;
-            ARDUINO_IO[0] <= 0;
-            ARDUINO_IO[1] <= 0;
+            tuning_word <= 0;
+            d_compare <= {CHANNELS{HALF_PERIOD}};
+            for (int c = 0; c <= CHANNELS; c++)
+                ARDUINO_IO[c] <= 0;
             LEDR <= 10'b0;
         end
         else begin
+            counter <= counter + 1'b1;
+            ARDUINO_IO[0] <= square[0];
+            for (int c = 0; c < CHANNELS; c++)
+                ARDUINO_IO[c + 1] <= modulated[c];
+            LEDR[0] <= modulated[0];
+            LEDR[1] <= sd_mode;
+            LEDR[3:2] <= step_sel;
+            LEDR[9:4] <= 0;
+            
             case (current_state)
                 S_RESET: begin
-                    counter <= 0;
-                    phase <= 0;
-                    d1_compare <= ((CLOCK_FREQ / freq)) >> 1;
-                    ARDUINO_IO[0] <= 0;
-                    ARDUINO_IO[1] <= 0;
-                    LEDR <= 10'b0;
+                    tuning_word <= tuning_target;
+                    for (int c = 0; c < CHANNELS; c++)
+                        ARDUINO_IO[c + 1] <= 0;
+                    LEDR[0] <= 0;
                 end
                 
                 S_COUNT: begin
-                    if (counter < counter_max)
-                        counter <= counter + 1;
-                    ARDUINO_IO[0] <= (counter < d0_compare);
-                    ARDUINO_IO[1] <= (counter < d1_compare);
-                    LEDR[0] <= (counter < d1_compare);
-                    LEDR[9:1] <= 0;
+                    // Output only, see modulated
                 end
                 
                 S_UPDATE: begin
-                    // Immediately update the frequency using the combinationally
-                    // computed new_freq.
+                    // Take the new frequency; its tuning word follows one
+                    // period later, at the next S_UPDATE. The accumulators
+                    // carry on, so retuning is phase continuous.
                     freq <= new_freq;
+                    tuning_word <= tuning_target;
                     
-                    // Recalculate modulation parameters using the (possibly) new frequency.
-                    scaled <= amplitude * sine_lut[phase];
-                    d1_compare <= (((CLOCK_FREQ / new_freq)) >> 1) + (scaled >>> 15);
-                    phase <= (phase == SAMPLE_COUNT - 1) ? 0 : phase + 1;
-                    counter <= 0;
-                    ARDUINO_IO[0] <= 0;
-                    ARDUINO_IO[1] <= 0;
-                    LEDR[0] <= 0;
+                    // This period's duty cycles from the sines.
+                    for (int c = 0; c < CHANNELS; c++)
+                        d_compare[c] <= HALF_PERIOD + PWM_BITS'($signed(sine[c]) >>> SINE_SHIFT);
                 end
             endcase
         end
     end
 endmodule
-
-//=============================================================================
-// Button_debounce with a two-FF synchronizer, a counter-based filter, and a
-// rising-edge detector that generates a single pulse per button press.
-//=============================================================================
-module button_debounce (
-    input logic clk,      // Clock signal
-    input logic rst,      // Synchronous reset (e.g., rst_sync)
-    input logic button,   // Raw button input
-    output logic pulse    // Single-cycle pulse on rising edge (debounced)
-);
-    // Step 1: Synchronize the raw button input to avoid metastability.
-    logic button_sync1, button_sync2;
-    always_ff @(posedge clk or posedge rst) begin
-        if (rst) begin
-            button_sync1 <= 1'b0;
-            button_sync2 <= 1'b0;
-        end
-        else begin
-            button_sync1 <= button;
-            button_sync2 <= button_sync1;
-        end
-    end
-    
-    // Step 2: Debounce filter using a counter.
-    localparam COUNTER_MAX = 20'hFFFFF;
-    logic [19:0] counter;
-    logic stable_button;
-    always_ff @(posedge clk or posedge rst) begin
-        if (rst) begin
-            counter <= 0;
-            stable_button <= button_sync2; // Assume initial state is stable
-        end
-        else begin
-            if (button_sync2 != stable_button)
-                counter <= 0; // Restart counter when a change is detected
-            else if (counter < COUNTER_MAX)
-                counter <= counter + 1;
-                
-            // Once stable for enough cycles, update the stable state.
-            if (counter == COUNTER_MAX)
-                stable_button <= button_sync2;
-        end
-    end
-    
-    // Step 3: Edge detector to generate a single pulse on the rising edge.
-    logic stable_button_prev;
-    always_ff @(posedge clk or posedge rst) begin
-        if (rst) begin
-            stable_button_prev <= 1'b0;
-            pulse <= 1'b0;
-        end
-        else begin
-            stable_button_prev <= stable_button;
-            pulse <= (~stable_button_prev) & stable_button;
-        end
-    end
-endmodule
\ No newline at end of file
@@ -2,17 +2,23 @@
 // Testbench for PWM modulated sine wave generator
 `timescale 1ns/1ps
 
-module pwm_modulated_sine_tb();
+module pwm_modulated_sine_tb #(
+  // Divides the DUT's time constants and this testbench's delays alike;
+  // override with e.g. vsim -gSIM_SPEEDUP=1 for real-time behaviour
+  parameter SIM_SPEEDUP = 100
+) ();
 
   // Clock and reset signals
   logic clk_50mhz;
-  logic [1:0] sw;
+  logic [3:0] sw;
   logic [1:0] key;
   logic [1:0] arduino_io;
   logic [9:0] ledr;
   
   // DUT Instantiation
-  pwm_modulated_sine dut(
+  pwm_modulated_sine #(
+    .SIM_SPEEDUP(SIM_SPEEDUP)
+  ) dut(
     .MAX10_CLK1_50(clk_50mhz),
     .SW(sw),
     .KEY(key),
@@ -20,6 +26,10 @@ module pwm_modulated_sine_tb();
     .LEDR(ledr)
   );
   
+  // Key press and release time: 20 ms outlasts the 16 ms debounce, and
+  // shrinks with it
+  localparam time PRESS = 20_000_000 / SIM_SPEEDUP;
+
   // For monitoring state of the DUT
   state_t current_state, next_state;
   assign current_state = dut.current_state;
@@ -34,7 +44,7 @@ module pwm_modulated_sine_tb();
   // Test procedure
   initial begin
     // Initialize inputs
-    sw = 2'b11;  // No reset
+    sw = 4'b0011;  // No reset, 100 Hz steps
     key = 2'b11; // No keys pressed (active low)
     
     // Apply reset
@@ -45,13 +55,12 @@ module pwm_modulated_sine_tb();
     // Wait for stabilization
     #1000;
     
-    // Check initial frequency - should be BASE_FREQ (1000 Hz)
-    $display("Initial frequency: %d Hz", dut.freq);
-    assert(dut.freq == 1000) else $error("Initial frequency not set to BASE_FREQ");
+    // Check initial frequency - should be BASE_FREQ (1000 Hz; freq counts 0.1 Hz)
+    $display("Initial frequency: %d Hz", dut.freq / 10);
+    assert(dut.freq == 10000) else $error("Initial frequency not set to BASE_FREQ");
     
-    // Calculate how long to wait for one full PWM cycle at 1kHz (1ms)
-    // 50,000 clock cycles at 50MHz = 1ms
-    #1000000;  // Wait for 1ms
+    // Wait for one full sine period at 1kHz (1ms)
+    #1000000;
     
     // Check PWM outputs are toggling
     $display("Checking PWM generation...");
@@ -61,49 +70,65 @@ module pwm_modulated_sine_tb();
     repeat(10) begin  // Press KEY[0] 10 times to increase by 1000Hz
       // Press KEY[0] (active low)
       key[0] = 0;
-      #1000000;  // Hold for 1ms
+      #(PRESS);  // Hold past the debounce time
       key[0] = 1;
-      #1000000;  // Wait 1ms between presses
+      #(PRESS);  // Wait as long between presses
       
       // Display and check current frequency
-      $display("Current frequency after increase: %d Hz", dut.freq);
+      $display("Current frequency after increase: %d Hz", dut.freq / 10);
     end
     
     // Test upper frequency limit (10kHz)
     $display("\nTesting upper frequency limit...");
     repeat(100) begin  // Try to go well beyond max
       key[0] = 0;
-      #500000;  // Hold for 0.5ms (faster for simulation)
+      #(PRESS);
       key[0] = 1;
-      #500000;  // Wait 0.5ms between presses
+      #(PRESS);
     end
-    $display("Frequency after attempting to exceed max: %d Hz", dut.freq);
-    assert(dut.freq <= 10000) else $error("Frequency exceeds MAX_FREQ");
+    $display("Frequency after attempting to exceed max: %d Hz", dut.freq / 10);
+    assert(dut.freq <= 100000) else $error("Frequency exceeds MAX_FREQ");
     
     // Test frequency decrease (press KEY[1])
     $display("\nTesting frequency decrease...");
     repeat(100) begin  // Press KEY[1] many times to reduce frequency
       // Press KEY[1] (active low)
       key[1] = 0;
-      #1000000;  // Hold for 1ms
+      #(PRESS);  // Hold past the debounce time
       key[1] = 1;
-      #1000000;  // Wait 1ms between presses
+      #(PRESS);  // Wait as long between presses
       
       // Every 10 decreases, show current frequency
       if (($time % 10) == 0)
-        $display("Current frequency after decrease: %d Hz", dut.freq);
+        $display("Current frequency after decrease: %d Hz", dut.freq / 10);
     end
     
     // Test lower frequency limit (100Hz)
     $display("\nTesting lower frequency limit...");
     repeat(10) begin  // Try to go below min
       key[1] = 0;
-      #1000000;  // Hold for 1ms
+      #(PRESS);
       key[1] = 1;
-      #1000000;  // Wait 1ms between presses
+      #(PRESS);
     end
-    $display("Frequency after attempting to go below min: %d Hz", dut.freq);
-    assert(dut.freq >= 100) else $error("Frequency below MIN_FREQ");
+    $display("Frequency after attempting to go below min: %d Hz", dut.freq / 10);
+    assert(dut.freq >= 1000) else $error("Frequency below MIN_FREQ");
+    
+    // Test the fine steps (SW[3:2]): 0.1 Hz, then 1 Hz, up from 100 Hz
+    $display("\nTesting fine frequency steps...");
+    sw[3:2] = 2'b11;
+    key[0] = 0;
+    #(PRESS);
+    key[0] = 1;
+    #(PRESS);
+    sw[3:2] = 2'b10;
+    key[0] = 0;
+    #(PRESS);
+    key[0] = 1;
+    #(PRESS);
+    sw[3:2] = 2'b00;
+    $display("Frequency after a 0.1 Hz and a 1 Hz step: %0d.%0d Hz", dut.freq / 10, dut.freq % 10);
+    assert(dut.freq == 1011) else $error("Fine steps did not give 101.1 Hz");
     
     // Test state transitions
     $display("\nTesting state transitions...");
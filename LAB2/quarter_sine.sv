@@ -0,0 +1,100 @@
+//=============================================================================
+// quarter_sine: sine of a phase from a quarter-wave LUT with linear
+// interpolation.
+//
+// phase is a fraction of a full turn: the top two bits pick the quadrant,
+// the next LUT_BITS index the quarter-wave table and the low FRAC_BITS
+// interpolate between neighbouring entries. Quadrants 1 and 3 read the
+// table mirrored, quadrants 2 and 3 negate it, so the table holds only
+// sin(0..pi/2) as 2**LUT_BITS + 2 unsigned 15-bit entries, a quarter of a
+// full-period table with the same resolution.
+//
+// The table is generated at elaboration (no .mif file and no Python
+// snippet), from a fixed-point Taylor series so only integer constant
+// arithmetic is needed. sine is Q15 (+/-32767) and appears three clocks
+// after phase.
+//=============================================================================
+module quarter_sine #(
+    parameter LUT_BITS = 6,    // Quarter wave in 2**LUT_BITS steps
+    parameter FRAC_BITS = 8    // Interpolation bits between steps
+) (
+    input logic clk,
+    input logic [LUT_BITS+FRAC_BITS+1:0] phase,
+    output logic signed [15:0] sine
+);
+    localparam X_BITS = LUT_BITS + FRAC_BITS;      // Phase within a quadrant
+    localparam longint HALF_PI_Q30 = 64'd1686629713;
+
+    //-------------------------------------------------------------------------
+    // round(32767 * sin(pi/2 * i / 2**LUT_BITS)). Taylor series to x**13 in
+    // Q30; the terms stay below 2**63 for x up to pi/2 and a bit beyond.
+    //-------------------------------------------------------------------------
+    function automatic logic [14:0] quarter_entry(input int i);
+        longint x, x2, term, sum;
+        x = (HALF_PI_Q30 * longint'(i)) >>> LUT_BITS;
+        x2 = (x * x) >>> 30;
+        term = x;
+        sum = x;
+        for (int n = 1; n <= 6; n++) begin
+            term = -((term * x2) >>> 30) / longint'((2 * n) * (2 * n + 1));
+            sum = sum + term;
+        end
+        sum = (sum * 32767 + (longint'(1) << 29)) >>> 30;
+        return (sum > 32767) ? 15'd32767 : 15'(sum);
+    endfunction
+
+    // Entry 2**LUT_BITS is sin(pi/2); the one after it is only ever read
+    // with a zero fraction, at the mirrored end of the quadrant.
+    logic [14:0] rom [0:(1 << LUT_BITS) + 1];
+
+    initial begin
+        for (int i = 0; i < (1 << LUT_BITS) + 2; i++)
+            rom[i] = quarter_entry(i);
+    end
+
+    //-------------------------------------------------------------------------
+    // Stage 1: fold the phase into the first quadrant and read both ends of
+    // the step it falls in.
+    //-------------------------------------------------------------------------
+    logic negate;
+    assign negate = phase[X_BITS+1];
+
+    logic [X_BITS:0] x;                            // 0 .. 2**X_BITS
+    assign x = phase[X_BITS] ? ((X_BITS+1)'(1) << X_BITS) - (X_BITS+1)'(phase[X_BITS-1:0])
+                             : (X_BITS+1)'(phase[X_BITS-1:0]);
+
+    logic [LUT_BITS:0] index;
+    assign index = x[X_BITS:FRAC_BITS];
+
+    logic [14:0] lo, hi;
+    logic [FRAC_BITS-1:0] frac;
+    logic negate1;
+
+    always_ff @(posedge clk) begin
+        lo <= rom[index];
+        hi <= rom[index + 1'b1];
+        frac <= x[FRAC_BITS-1:0];
+        negate1 <= negate;
+    end
+
+    //-------------------------------------------------------------------------
+    // Stage 2: interpolate. The quarter wave rises, so hi - lo >= 0.
+    //-------------------------------------------------------------------------
+    logic [14+FRAC_BITS:0] slope;
+    logic [14:0] level;
+    logic negate2;
+
+    assign slope = (15+FRAC_BITS)'(hi - lo) * (15+FRAC_BITS)'(frac);
+
+    always_ff @(posedge clk) begin
+        level <= lo + slope[14+FRAC_BITS:FRAC_BITS];
+        negate2 <= negate1;
+    end
+
+    //-------------------------------------------------------------------------
+    // Stage 3: sign from the half of the turn.
+    //-------------------------------------------------------------------------
+    always_ff @(posedge clk) begin
+        sine <= negate2 ? -$signed({1'b0, level}) : $signed({1'b0, level});
+    end
+endmodule
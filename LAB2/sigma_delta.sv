@@ -0,0 +1,39 @@
+//=============================================================================
+// sigma_delta: first- or second-order sigma-delta modulator, one output bit
+// per clock.
+//
+// x is Q15 and is used at half scale, the same 25%-75% swing as the PWM
+// duty in pwm_modulated_sine; the 1-bit feedback is +/- full scale. For
+// such an input the integrators stay within 2.3 (i1) and 4.2 (i2) times
+// full scale, well inside SD_BITS. The quantization noise rises with
+// frequency, 20 dB/decade per order, out of the band an RC filter passes.
+//=============================================================================
+module sigma_delta #(
+    parameter ORDER = 2        // 1 or 2
+) (
+    input logic clk,
+    input logic rst,           // Synchronous, clears the integrators
+    input logic signed [15:0] x,
+    output logic out
+);
+    localparam SD_BITS = 20;
+    localparam logic signed [SD_BITS-1:0] SD_FULL = SD_BITS'(1 << 15);
+
+    logic signed [SD_BITS-1:0] sd_x, sd_fb, sd_i1, sd_i1_next, sd_i2;
+
+    assign sd_x = SD_BITS'(x >>> 1);
+    assign sd_fb = out ? SD_FULL : -SD_FULL;
+    assign sd_i1_next = sd_i1 + sd_x - sd_fb;
+    assign out = (ORDER == 1) ? !sd_i1[SD_BITS-1] : !sd_i2[SD_BITS-1];
+
+    always_ff @(posedge clk) begin
+        if (rst) begin
+            sd_i1 <= 0;
+            sd_i2 <= 0;
+        end
+        else begin
+            sd_i1 <= sd_i1_next;
+            sd_i2 <= sd_i2 + sd_i1_next - sd_fb;
+        end
+    end
+endmodule
@@ -0,0 +1,298 @@
+/**
+ * sim_main.cpp - Verilator spectral analysis of pwm_modulated_sine
+ *
+ * Steps the sine through a list of frequencies with KEY[0]/KEY[1], as a
+ * user would, and at each one low-pass filters ARDUINO_IO[1] in software,
+ * takes an FFT and reports the fundamental's frequency error, the THD and
+ * the SFDR (spectrum.h). The run ends with the simulated cycles per
+ * wall-clock second.
+ *
+ * The filter is a sinc^3 CIC decimating by --decim, and THD and SFDR only
+ * count the band below --band: with the defaults the PWM carrier
+ * (48.8 kHz) is out of it but its sidebands that fall below 20 kHz are
+ * in, as they would be behind an audio filter.
+ *
+ * --save writes each step's THD and SFDR; --compare checks them against
+ * such a file and fails if THD rose or SFDR fell by more than
+ * --tolerance dB at any frequency, so LUT, interpolation and modulator
+ * changes can be tracked as a regression.
+ *
+ * Usage: Vpwm_sine [options]
+ *   --freq F          measure at F Hz, a multiple of 100 in 100..10000;
+ *                     repeat for more steps (default 100 1000 5000 10000)
+ *   --sd              sigma-delta output (SW[1] up) instead of PWM
+ *   --points N        FFT size, a power of two (default 65536)
+ *   --decim R         clocks per filtered sample (default 64)
+ *   --band HZ         top of the THD/SFDR band (default 20000)
+ *   --save FILE       write the results for --compare
+ *   --compare FILE    compare with saved results
+ *   --tolerance DB    allowed THD/SFDR loss with --compare (default 1)
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "verilated.h"
+#include "Vpwm_sine.h"
+#include "Vpwm_sine___024root.h"
+#include "spectrum.h"
+
+#ifndef SIM_SPEEDUP
+#define SIM_SPEEDUP 1
+#endif
+#ifndef PWM_BITS
+#define PWM_BITS 10
+#endif
+
+static const double CLOCK_FREQ = 50e6;
+
+// pwm_modulated_sine's frequency range and key step
+static const unsigned MIN_FREQ = 100;
+static const unsigned MAX_FREQ = 10000;
+static const unsigned STEP_FREQ = 100;
+
+// Cycles SW[0] (reset) is held low at start-up
+static const int RESET_CYCLES = 100;
+
+// A key is held, and then left released, for 20 ms of board time: longer
+// than the debouncer's 16 ms, scaled down with it
+static const uint64_t HOLD_CYCLES = 1000000 / SIM_SPEEDUP > 64 ? 1000000 / SIM_SPEEDUP : 64;
+
+// After the last key press: the new tuning word is taken one PWM period
+// after the frequency, then the LUT pipeline and the filter settle
+static const uint64_t SETTLE_CYCLES = 4 << PWM_BITS;
+static const int SETTLE_SAMPLES = 8;
+
+class Harness {
+public:
+    Harness(int argc, char** argv)
+        : contextp_(std::make_unique<VerilatedContext>()) {
+        contextp_->commandArgs(argc, argv);
+        top_ = std::make_unique<Vpwm_sine>(contextp_.get());
+        top_->MAX10_CLK1_50 = 0;
+        top_->KEY = 0x3;                // Active low: nothing pressed
+        top_->SW = 0;                   // SW[0] low holds the design in reset
+    }
+
+    ~Harness() { top_->final(); }
+
+    // One 50 MHz cycle; returns ARDUINO_IO[1] after the edge
+    bool tick() {
+        top_->MAX10_CLK1_50 = 1;
+        top_->eval();
+        contextp_->timeInc(10);
+        top_->MAX10_CLK1_50 = 0;
+        top_->eval();
+        contextp_->timeInc(10);
+        cycles_++;
+        return top_->ARDUINO_IO[1];
+    }
+
+    void run(uint64_t n) {
+        for (uint64_t i = 0; i < n; i++)
+            tick();
+    }
+
+    void reset(bool sd) {
+        top_->SW = 0;
+        run(RESET_CYCLES);
+        top_->SW = sd ? 0x3 : 0x1;
+        run(RESET_CYCLES);
+    }
+
+    // freq counts 0.1 Hz; SW[3:2] is left at 0, the 100 Hz key step
+    unsigned freq() const { return top_->rootp->pwm_modulated_sine__DOT__freq / 10; }
+
+    // Press and release KEY[key]; false if the frequency did not change
+    bool press(int key) {
+        const unsigned before = freq();
+        top_->KEY = 0x3 & ~(1u << key);
+        run(HOLD_CYCLES);
+        top_->KEY = 0x3;
+        for (uint64_t i = 0; i < 2 * HOLD_CYCLES + (2 << PWM_BITS); i++) {
+            tick();
+            if (freq() != before) {
+                run(HOLD_CYCLES);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint64_t cycles() const { return cycles_; }
+
+private:
+    std::unique_ptr<VerilatedContext> contextp_;
+    std::unique_ptr<Vpwm_sine> top_;
+    uint64_t cycles_ = 0;
+};
+
+struct Step {
+    double thd_db;
+    double sfdr_db;
+};
+
+static void usage(const char* prog) {
+    std::fprintf(stderr,
+                 "usage: %s [--freq F]... [--sd] [--points N] [--decim R] [--band HZ] "
+                 "[--save FILE] [--compare FILE] [--tolerance DB]\n",
+                 prog);
+    std::exit(2);
+}
+
+// Saved results: one "freq thd_db sfdr_db" line per step
+static bool load(const std::string& path, std::map<unsigned, Step>& steps) {
+    FILE* fp = std::fopen(path.c_str(), "r");
+    if (!fp) {
+        std::perror(path.c_str());
+        return false;
+    }
+    unsigned f;
+    Step s;
+    while (std::fscanf(fp, "%u %lf %lf", &f, &s.thd_db, &s.sfdr_db) == 3)
+        steps[f] = s;
+    std::fclose(fp);
+    return true;
+}
+
+static bool save(const std::string& path, const std::map<unsigned, Step>& steps) {
+    FILE* fp = std::fopen(path.c_str(), "w");
+    if (!fp) {
+        std::perror(path.c_str());
+        return false;
+    }
+    for (const auto& [f, s] : steps)
+        std::fprintf(fp, "%u %.2f %.2f\n", f, s.thd_db, s.sfdr_db);
+    std::fclose(fp);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::vector<unsigned> freqs;
+    bool sd = false;
+    size_t points = 65536;
+    unsigned decim = 64;
+    double band = 20000.0;
+    std::string save_path;
+    std::string compare_path;
+    double tolerance = 1.0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--freq" && has_value) {
+            unsigned f = std::strtoul(argv[++i], nullptr, 0);
+            if (f < MIN_FREQ || f > MAX_FREQ || f % STEP_FREQ != 0)
+                usage(argv[0]);
+            freqs.push_back(f);
+        } else if (arg == "--sd") {
+            sd = true;
+        } else if (arg == "--points" && has_value) {
+            points = std::strtoull(argv[++i], nullptr, 0);
+            if (points < 1024 || (points & (points - 1)) != 0)
+                usage(argv[0]);
+        } else if (arg == "--decim" && has_value) {
+            decim = std::strtoul(argv[++i], nullptr, 0);
+            if (decim == 0)
+                usage(argv[0]);
+        } else if (arg == "--band" && has_value) {
+            band = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--save" && has_value) {
+            save_path = argv[++i];
+        } else if (arg == "--compare" && has_value) {
+            compare_path = argv[++i];
+        } else if (arg == "--tolerance" && has_value) {
+            tolerance = std::strtod(argv[++i], nullptr);
+        } else if (arg.rfind("+verilator", 0) == 0) {
+            // Verilator runtime options, handled by commandArgs
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (freqs.empty())
+        freqs = {100, 1000, 5000, 10000};
+
+    const double fs = CLOCK_FREQ / decim;
+    band = std::min(band, fs / 2);
+
+    std::map<unsigned, Step> baseline;
+    if (!compare_path.empty() && !load(compare_path, baseline))
+        return 1;
+
+    Harness h(argc, argv);
+    auto start = std::chrono::steady_clock::now();
+    h.reset(sd);
+
+    std::printf("%s output, %zu-point FFT at %.1f kHz, band %.1f kHz\n",
+                sd ? "sigma-delta" : "PWM", points, fs / 1e3, band / 1e3);
+
+    std::map<unsigned, Step> results;
+    int failed = 0;
+
+    for (unsigned target : freqs) {
+        while (h.freq() != target) {
+            int key = h.freq() < target ? 0 : 1;
+            if (!h.press(key)) {
+                std::fprintf(stderr, "KEY[%d] press not seen at %u Hz\n", key, h.freq());
+                return 1;
+            }
+        }
+        h.run(SETTLE_CYCLES);
+
+        spectrum::Decimator lowpass(decim);
+        std::vector<double> samples;
+        samples.reserve(points);
+        int skip = SETTLE_SAMPLES;
+        while (samples.size() < points) {
+            if (!lowpass.push(h.tick()))
+                continue;
+            if (skip > 0)
+                skip--;
+            else
+                samples.push_back(lowpass.sample());
+        }
+
+        spectrum::ToneReport r = spectrum::analyze(samples, fs, target, band);
+        const double err = r.freq - target;
+        std::printf("%5u Hz: measured %.3f Hz (%+.3f Hz, %+.1f ppm), THD %.2f dB (%d harmonic%s), "
+                    "SFDR %.2f dBc (spur at %.1f Hz)\n",
+                    target, r.freq, err, err / target * 1e6, r.thd_db, r.harmonics,
+                    r.harmonics == 1 ? "" : "s", r.sfdr_db, r.spur_freq);
+        results[target] = {r.thd_db, r.sfdr_db};
+
+        auto base = baseline.find(target);
+        if (base != baseline.end()) {
+            if (r.thd_db > base->second.thd_db + tolerance) {
+                std::printf("REGRESSION %u Hz: THD %.2f -> %.2f dB\n", target,
+                            base->second.thd_db, r.thd_db);
+                failed++;
+            }
+            if (r.sfdr_db < base->second.sfdr_db - tolerance) {
+                std::printf("REGRESSION %u Hz: SFDR %.2f -> %.2f dBc\n", target,
+                            base->second.sfdr_db, r.sfdr_db);
+                failed++;
+            }
+        } else if (!compare_path.empty()) {
+            std::printf("%u Hz: not in %s\n", target, compare_path.c_str());
+        }
+    }
+
+    auto stop = std::chrono::steady_clock::now();
+    double secs = std::chrono::duration<double>(stop - start).count();
+
+    std::printf("%llu cycles in %.3f s: %.2f Mcycles/s (%.4f s of board time per second)\n",
+                static_cast<unsigned long long>(h.cycles()), secs,
+                secs > 0 ? h.cycles() / secs / 1e6 : 0.0,
+                secs > 0 ? h.cycles() / CLOCK_FREQ / secs : 0.0);
+
+    if (!save_path.empty() && !save(save_path, results))
+        return 1;
+    return failed ? 1 : 0;
+}
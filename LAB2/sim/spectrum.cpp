@@ -0,0 +1,147 @@
+/**
+ * spectrum.cpp - Low-pass decimation and tone analysis, see spectrum.h
+ */
+
+#include "spectrum.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace spectrum {
+
+// Bins either side of a tone's peak that hold its main lobe (Blackman-Harris
+// is 8 bins wide, plus one for a tone between bins)
+static const int LOBE = 5;
+
+Decimator::Decimator(unsigned ratio)
+    : ratio_(ratio), scale_(1.0 / (static_cast<double>(ratio) * ratio * ratio)) {}
+
+bool Decimator::push(bool bit) {
+    i1_ += bit ? 1 : static_cast<uint64_t>(-1);
+    i2_ += i1_;
+    i3_ += i2_;
+    if (++phase_ < ratio_)
+        return false;
+    phase_ = 0;
+
+    uint64_t d1 = i3_ - c1_;
+    c1_ = i3_;
+    uint64_t d2 = d1 - c2_;
+    c2_ = d1;
+    uint64_t d3 = d2 - c3_;
+    c3_ = d2;
+    sample_ = static_cast<int64_t>(d3) * scale_;
+    return true;
+}
+
+// In-place iterative radix-2 FFT; x.size() is a power of two
+static void fft(std::vector<std::complex<double>>& x) {
+    const size_t n = x.size();
+    for (size_t i = 1, j = 0; i < n; i++) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j |= bit;
+        if (i < j)
+            std::swap(x[i], x[j]);
+    }
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const double a = -2.0 * M_PI / len;
+        const std::complex<double> w(std::cos(a), std::sin(a));
+        for (size_t i = 0; i < n; i += len) {
+            std::complex<double> wk(1.0, 0.0);
+            for (size_t k = 0; k < len / 2; k++) {
+                std::complex<double> u = x[i + k];
+                std::complex<double> v = x[i + k + len / 2] * wk;
+                x[i + k] = u + v;
+                x[i + k + len / 2] = u - v;
+                wk *= w;
+            }
+        }
+    }
+}
+
+// Where a tone of frequency f lands after sampling at fs, in bins
+static long folded_bin(double f, double fs, size_t n) {
+    double g = std::fmod(f, fs);
+    if (g > fs / 2)
+        g = fs - g;
+    return std::lround(g / fs * n);
+}
+
+ToneReport analyze(const std::vector<double>& samples, double fs, double expected, double band) {
+    const size_t n = samples.size();
+    const double bin_hz = fs / n;
+
+    // Window, after removing the mean (the output's DC level says nothing
+    // about the tone and would spill into the low bins)
+    double mean = 0.0;
+    for (double s : samples)
+        mean += s;
+    mean /= n;
+
+    std::vector<std::complex<double>> x(n);
+    for (size_t i = 0; i < n; i++) {
+        const double t = 2.0 * M_PI * i / n;
+        const double w = 0.35875 - 0.48829 * std::cos(t) + 0.14128 * std::cos(2 * t) -
+                         0.01168 * std::cos(3 * t);
+        x[i] = (samples[i] - mean) * w;
+    }
+    fft(x);
+
+    const long top = std::min<long>(std::lround(band / bin_hz), n / 2);
+    std::vector<double> power(top + 1);
+    for (long k = 0; k <= top; k++)
+        power[k] = std::norm(x[k]);
+
+    auto lobe_power = [&](long centre) {
+        double p = 0.0;
+        for (long k = std::max(centre - LOBE, 0L); k <= std::min(centre + LOBE, top); k++)
+            p += power[k];
+        return p;
+    };
+
+    // Fundamental: the highest bin near the expected frequency
+    long fund = std::min(std::max(std::lround(expected / bin_hz), 1L), top);
+    for (long k = std::max(fund - 2 * LOBE, 1L); k <= std::min(fund + 2 * LOBE, top); k++)
+        if (power[k] > power[fund])
+            fund = k;
+
+    ToneReport r;
+    double p_fund = 0.0, centroid = 0.0;
+    for (long k = std::max(fund - LOBE, 0L); k <= std::min(fund + LOBE, top); k++) {
+        p_fund += power[k];
+        centroid += k * power[k];
+    }
+    r.freq = p_fund > 0 ? centroid / p_fund * bin_hz : 0.0;
+
+    // Harmonics, folded back below fs / 2 where they alias
+    double p_harm = 0.0;
+    for (int h = 2; h <= MAX_HARMONIC; h++) {
+        long k = folded_bin(h * r.freq, fs, n);
+        if (k <= LOBE || k > top || std::labs(k - fund) <= 2 * LOBE)
+            continue;
+        p_harm += lobe_power(k);
+        r.harmonics++;
+    }
+    r.thd_db = p_harm > 0 ? 10.0 * std::log10(p_harm / p_fund) : -INFINITY;
+
+    // Largest spur outside DC and the fundamental's lobe
+    long spur = -1;
+    for (long k = LOBE + 1; k <= top; k++) {
+        if (std::labs(k - fund) <= LOBE)
+            continue;
+        if (spur < 0 || power[k] > power[spur])
+            spur = k;
+    }
+    if (spur >= 0 && power[spur] > 0) {
+        r.sfdr_db = 10.0 * std::log10(power[fund] / power[spur]);
+        r.spur_freq = spur * bin_hz;
+    } else {
+        r.sfdr_db = INFINITY;
+    }
+    return r;
+}
+
+}  // namespace spectrum
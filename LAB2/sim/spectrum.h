@@ -0,0 +1,64 @@
+/**
+ * spectrum.h - Low-pass decimation and tone analysis of a 1-bit output
+ *
+ * Decimator is a CIC (sinc^3) low-pass filter: it takes the output pin as
+ * one bit per clock and gives one sample per `ratio` clocks, scaled to
+ * +/-1 (all ones = +1, all zeros = -1). It stands in for the RC filter on
+ * the board, with nulls at multiples of the output rate.
+ *
+ * analyze() windows a block of those samples (4-term Blackman-Harris,
+ * sidelobes below -92 dB), takes a radix-2 FFT and measures the tone
+ * nearest the expected frequency:
+ *   freq   power-weighted centre of the fundamental's main lobe
+ *   thd    harmonics 2..MAX_HARMONIC inside the band, against the
+ *          fundamental, each summed over its main lobe
+ *   sfdr   fundamental peak against the highest other bin in the band
+ *          (DC excluded)
+ * so a spur counts whether or not it is a harmonic: PWM carrier sidebands
+ * and sigma-delta idle tones show up in sfdr.
+ */
+
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+#include <cstdint>
+#include <vector>
+
+namespace spectrum {
+
+static const int MAX_HARMONIC = 10;
+
+class Decimator {
+public:
+    explicit Decimator(unsigned ratio);
+
+    // One clock's output bit; true when a new sample is ready
+    bool push(bool bit);
+    double sample() const { return sample_; }
+
+private:
+    unsigned ratio_;
+    unsigned phase_ = 0;
+    // Integrators at the clock rate, combs at the sample rate. They wrap
+    // (unsigned), which the combs undo exactly.
+    uint64_t i1_ = 0, i2_ = 0, i3_ = 0;
+    uint64_t c1_ = 0, c2_ = 0, c3_ = 0;
+    double scale_;
+    double sample_ = 0.0;
+};
+
+struct ToneReport {
+    double freq = 0.0;          // Measured fundamental, Hz
+    double thd_db = 0.0;        // Harmonic power / fundamental power, dB
+    double sfdr_db = 0.0;       // Fundamental / largest spur, dBc
+    double spur_freq = 0.0;     // Where the largest spur is, Hz
+    int harmonics = 0;          // Harmonics that fell inside the band
+};
+
+// samples.size() must be a power of two; fs is their rate, band the top of
+// the analysis band (at most fs / 2)
+ToneReport analyze(const std::vector<double>& samples, double fs, double expected, double band);
+
+}  // namespace spectrum
+
+#endif
@@ -0,0 +1,107 @@
+//=============================================================================
+// sine_bank: CHANNELS phase-coherent DDS sine generators sharing one
+// quarter-wave LUT (quarter_sine.sv).
+//
+// Every channel has its own 32-bit phase accumulator, advanced by its
+// tuning word every clock, plus a phase offset and an amplitude. The LUT is
+// time-multiplexed: once every CHANNELS clocks all channels' phases are
+// captured together, fed through the LUT and one shared amplitude
+// multiplier on successive clocks, and the results are presented together.
+// So all channels are sampled at the same instant (3-phase or I/Q stay
+// exactly in step) at CLOCK_FREQ / CHANNELS each, and a channel costs its
+// accumulator and a few registers, not a LUT or a multiplier.
+//
+// sine[c] is Q15 (two's complement), scaled by amplitude[c] / 2**16, and
+// changes only in the clock after update. Channels with equal tuning words
+// keep their offsets exactly, as rst starts all accumulators together.
+//=============================================================================
+module sine_bank #(
+    parameter CHANNELS = 2,
+    parameter LUT_BITS = 6,    // Quarter-wave sine LUT of 2**LUT_BITS steps
+    parameter FRAC_BITS = 8    // Interpolation bits between LUT steps
+) (
+    input logic clk,
+    input logic rst,                                // Synchronous, clears the accumulators
+    input logic [CHANNELS-1:0][31:0] tuning_word,   // Frequency: tuning_word * f_clk / 2**32
+    input logic [CHANNELS-1:0][31:0] phase_offset,  // Fraction of a turn, * 2**32
+    input logic [CHANNELS-1:0][15:0] amplitude,     // Unsigned, 16'hFFFF ~ 1
+    output logic [CHANNELS-1:0] square,             // 50% square wave per channel
+    output logic [CHANNELS-1:0][15:0] sine,         // Q15 per channel
+    output logic update                             // sine changes on the next clock
+);
+    localparam PHASE_BITS = LUT_BITS + FRAC_BITS + 2;
+    localparam SLOT_BITS = (CHANNELS > 1) ? $clog2(CHANNELS) : 1;
+    localparam logic [SLOT_BITS-1:0] LAST_SLOT = SLOT_BITS'(CHANNELS - 1);
+
+    //-------------------------------------------------------------------------
+    // Per-channel accumulators, and the phase snapshot taken as the last
+    // slot of a round goes into the LUT
+    //-------------------------------------------------------------------------
+    logic [CHANNELS-1:0][31:0] phase_acc;
+    logic [CHANNELS-1:0][31:0] phase;
+    logic [CHANNELS-1:0][PHASE_BITS-1:0] snapshot;
+    logic [SLOT_BITS-1:0] slot;
+
+    always_comb begin
+        for (int c = 0; c < CHANNELS; c++)
+            phase[c] = phase_acc[c] + phase_offset[c];
+    end
+
+    always_ff @(posedge clk) begin
+        if (rst) begin
+            phase_acc <= '0;
+            slot <= 0;
+        end
+        else begin
+            for (int c = 0; c < CHANNELS; c++) begin
+                phase_acc[c] <= phase_acc[c] + tuning_word[c];
+                square[c] <= phase[c][31];
+            end
+            slot <= (slot == LAST_SLOT) ? '0 : slot + 1'b1;
+        end
+
+        if (slot == LAST_SLOT) begin
+            for (int c = 0; c < CHANNELS; c++)
+                snapshot[c] <= phase[c][31 -: PHASE_BITS];
+        end
+    end
+
+    //-------------------------------------------------------------------------
+    // Shared LUT: one channel per clock, three clocks of latency
+    //-------------------------------------------------------------------------
+    logic signed [15:0] lut_sine;
+
+    quarter_sine #(
+        .LUT_BITS(LUT_BITS),
+        .FRAC_BITS(FRAC_BITS)
+    ) sine_rom (
+        .clk(clk),
+        .phase(snapshot[slot]),
+        .sine(lut_sine)
+    );
+
+    // Channel of each pipeline stage
+    logic [SLOT_BITS-1:0] slot_d1, slot_d2, slot_d3, slot_d4;
+
+    always_ff @(posedge clk) begin
+        slot_d1 <= slot;
+        slot_d2 <= slot_d1;
+        slot_d3 <= slot_d2;
+        slot_d4 <= slot_d3;
+    end
+
+    //-------------------------------------------------------------------------
+    // Shared amplitude multiplier, then the round's results are collected
+    // and presented together
+    //-------------------------------------------------------------------------
+    logic signed [32:0] scaled;
+    logic [CHANNELS-1:0][15:0] collected;
+
+    always_ff @(posedge clk) begin
+        scaled <= 33'(lut_sine) * 33'($signed({1'b0, amplitude[slot_d3]}));
+        collected[slot_d4] <= 16'(scaled >>> 16);
+        update <= (slot_d4 == LAST_SLOT);
+        if (update)
+            sine <= collected;
+    end
+endmodule
@@ -0,0 +1,167 @@
+// sine_bank with CHANNELS time-multiplexed channels, against a model of
+// the phase accumulators and the sine.
+//
+// First 3-phase: equal tuning words, offsets a third of a turn apart and
+// full amplitude. Every sample of channel c must be the sine of channel 0's
+// phase plus c * 120 degrees, and the three must sum to about zero. Then
+// each channel gets its own tuning word, offset and amplitude, so a result
+// collected into the wrong channel, or scaled by another channel's
+// amplitude, shows up as a wrong sample.
+//
+// The model captures the phases on the same clock as sine_bank (the last
+// slot of a round) and checks each round's samples when they appear. The
+// first round after rst reads the phases captured before it and is skipped.
+`timescale 1ns/1ps
+
+module sine_bank_tb #(
+    parameter CHANNELS = 3,
+    parameter LUT_BITS = 6,
+    parameter FRAC_BITS = 8,
+    parameter ROUNDS = 2000                          // Rounds of samples per test
+)();
+    localparam PHASE_BITS = LUT_BITS + FRAC_BITS + 2;
+    localparam TOLERANCE = 8;                        // LSBs of Q15, interpolation and truncation
+    localparam real PI = 3.14159265358979;
+
+    logic clk;
+    logic rst;
+    logic [CHANNELS-1:0][31:0] tuning_word;
+    logic [CHANNELS-1:0][31:0] phase_offset;
+    logic [CHANNELS-1:0][15:0] amplitude;
+    logic [CHANNELS-1:0] square;
+    logic [CHANNELS-1:0][15:0] sine;
+    logic update;
+
+    sine_bank #(
+        .CHANNELS(CHANNELS),
+        .LUT_BITS(LUT_BITS),
+        .FRAC_BITS(FRAC_BITS)
+    ) dut (
+        .clk(clk),
+        .rst(rst),
+        .tuning_word(tuning_word),
+        .phase_offset(phase_offset),
+        .amplitude(amplitude),
+        .square(square),
+        .sine(sine),
+        .update(update)
+    );
+
+    // Clock generation
+    initial begin
+        clk = 0;
+        forever #10 clk = ~clk; // 50MHz clock
+    end
+
+    // Expected Q15 sample for a PHASE_BITS phase and an amplitude
+    function automatic real expected(input logic [PHASE_BITS-1:0] phase, input logic [15:0] amp);
+        return 32767.0 * $sin(2.0 * PI * phase / (2.0 ** PHASE_BITS)) * amp / 65536.0;
+    endfunction
+
+    int errors = 0;
+    int checked = 0;                                 // Rounds checked in the current test
+    logic three_phase = 0;                           // Also check the 3-phase sum
+
+    // Model: accumulators, slot and the phases captured each round, oldest
+    // first. Everything here samples the DUT's signals before the clock edge.
+    logic [CHANNELS-1:0][31:0] model_acc;
+    int model_slot;
+    logic [CHANNELS-1:0][PHASE_BITS-1:0] captured [$];
+    logic check_next;                                // sine holds a new round
+    logic skip;                                      // and it is the first after rst
+
+    always @(posedge clk) begin
+        if (rst) begin
+            model_acc = '0;
+            model_slot = 0;
+            captured.delete();
+            check_next = 0;
+            skip = 1;
+        end else begin
+            if (check_next) begin
+                if (skip) begin
+                    skip = 0;
+                end else if (captured.size() == 0) begin
+                    errors++;
+                    $display("%0t: samples with no phases captured for them", $time);
+                end else begin
+                    logic [CHANNELS-1:0][PHASE_BITS-1:0] phases;
+                    real sum;
+
+                    phases = captured.pop_front();
+                    sum = 0.0;
+                    for (int c = 0; c < CHANNELS; c++) begin
+                        real want;
+                        want = expected(phases[c], amplitude[c]);
+                        sum += $signed(sine[c]);
+                        if ($signed(sine[c]) > want + TOLERANCE || $signed(sine[c]) < want - TOLERANCE) begin
+                            errors++;
+                            $display("%0t: channel %0d gave %0d, expected %0.1f (phase %h)",
+                                     $time, c, $signed(sine[c]), want, phases[c]);
+                        end
+                    end
+                    if (three_phase && (sum > 3 * TOLERANCE || sum < -3 * TOLERANCE)) begin
+                        errors++;
+                        $display("%0t: 3-phase samples sum to %0.1f", $time, sum);
+                    end
+                    checked++;
+                end
+            end
+            check_next = update;
+
+            if (model_slot == CHANNELS - 1) begin
+                logic [CHANNELS-1:0][PHASE_BITS-1:0] phases;
+                for (int c = 0; c < CHANNELS; c++)
+                    phases[c] = 32'(model_acc[c] + phase_offset[c]) >> (32 - PHASE_BITS);
+                captured.push_back(phases);
+            end
+            for (int c = 0; c < CHANNELS; c++)
+                model_acc[c] = model_acc[c] + tuning_word[c];
+            model_slot = (model_slot == CHANNELS - 1) ? 0 : model_slot + 1;
+        end
+    end
+
+    // With rst held and the inputs set: run ROUNDS rounds and check they
+    // were all seen
+    task automatic run(input string name);
+        repeat (8) @(negedge clk);
+        checked = 0;
+        rst = 0;
+        repeat ((ROUNDS + 2) * CHANNELS + 8) @(negedge clk);
+        if (checked < ROUNDS) begin
+            errors++;
+            $display("%s: %0d rounds checked, expected %0d", name, checked, ROUNDS);
+        end
+        $display("%s: %0d rounds checked", name, checked);
+    endtask
+
+    // Test sequence
+    initial begin
+        // 3-phase: channel c a third of a turn on from channel c - 1. The
+        // tuning word gives about 225 clocks per period, so the rounds cover
+        // every part of the wave.
+        three_phase = (CHANNELS == 3);
+        rst = 1;
+        for (int c = 0; c < CHANNELS; c++) begin
+            tuning_word[c] = 32'h0123_4567;
+            phase_offset[c] = 32'((64'(c) << 32) / CHANNELS);
+            amplitude[c] = 16'hFFFF;
+        end
+        run("3-phase");
+
+        // Independent channels
+        @(negedge clk) rst = 1;
+        three_phase = 0;
+        for (int c = 0; c < CHANNELS; c++) begin
+            tuning_word[c] = 32'h0123_4567 * (c + 1) + 32'h0010_1010 * c;
+            phase_offset[c] = 32'h4000_0000 * c + 32'h0123_0000;
+            amplitude[c] = 16'hFFFF >> c;
+        end
+        run("independent");
+
+        if (errors != 0)
+            $error("sine_bank_tb FAILED");
+        $finish;
+    end
+
+endmodule
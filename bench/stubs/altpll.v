@@ -0,0 +1,27 @@
+// Stand-in for the Intel altpll megafunction, so designs with a PLL
+// elaborate in Yosys. Every output clock is the input clock: the ratio
+// does not matter for counting resources, and a PLL output left undriven
+// would let Yosys fold away all the logic it clocks.
+module altpll #(
+    parameter bandwidth_type = "AUTO",
+    parameter clk0_divide_by = 1,
+    parameter clk0_duty_cycle = 50,
+    parameter clk0_multiply_by = 1,
+    parameter clk0_phase_shift = "0",
+    parameter inclk0_input_frequency = 20000,
+    parameter intended_device_family = "MAX 10",
+    parameter lpm_type = "altpll",
+    parameter operation_mode = "NORMAL",
+    parameter pll_type = "AUTO",
+    parameter width_clock = 5
+)(
+    input areset,
+    input [1:0] inclk,
+    output [width_clock-1:0] clk,
+    output locked
+);
+
+    assign clk = {width_clock{inclk[0]}};
+    assign locked = ~areset;
+
+endmodule
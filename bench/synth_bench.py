@@ -0,0 +1,261 @@
+#!/usr/bin/env python3
+"""Resource and logic-depth regression benchmark for every HDL top.
+
+Each design is synthesized with Yosys for 4-input LUTs (a MAX 10 LE):
+
+  luts         $lut cells after abc -lut 4
+  ffs          flip-flops and latches
+  memory_bits  bits in inferred memories, before mapping
+  m9k          memories mapped onto M9K blocks (see m9k.txt)
+  multipliers  $mul/$macc cells left after the coarse passes
+  lut_depth    longest combinational path, in LUTs (ltp -noff)
+
+MAX 10 has no open timing model, so lut_depth stands in for Fmax: each
+level is one LE and its routing. Multipliers are counted and then built
+from LUTs, so the LUT count includes them where Quartus would use the
+embedded 9x9 multipliers.
+
+  synth_bench.py run               synthesize and compare with baseline.json
+  synth_bench.py baseline          synthesize and rewrite baseline.json
+  synth_bench.py run -d snake_game -t 10
+
+A metric regresses when it grows by more than the threshold (percent of
+its baseline, at least one unit). A design with no baseline fails `run`;
+record one with `baseline` first. Counts depend on the Yosys version, so
+the version is kept in the baseline and a mismatch is reported.
+
+The sources are read with the yosys-slang plugin (read_slang), not Yosys'
+own read_verilog -sv, which does not take the SystemVerilog the snake
+design uses: snake_pkg's struct assignment patterns, `typedef enum int`,
+and pwm_modulated_sine's unpacked ARDUINO_IO port. Build or install the
+plugin so that `yosys -m slang` loads it.
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+
+BENCH_DIR = os.path.dirname(os.path.abspath(__file__))
+REPO_DIR = os.path.dirname(BENCH_DIR)
+OUT_DIR = os.path.join(BENCH_DIR, "out")
+BASELINE = os.path.join(BENCH_DIR, "baseline.json")
+ALTPLL_STUB = os.path.join(BENCH_DIR, "stubs", "altpll.v")
+M9K_RULES = os.path.join(BENCH_DIR, "m9k.txt")
+
+# Yosys runs in each design's directory, so the file names below (relative
+# to it, as in the Quartus projects) have no spaces in them.
+DESIGNS = {
+    "fsm_multiplier": {
+        "dir": "LAB1",
+        "top": "fsm_multiplier",
+        "files": ["../common/debouncer.sv",
+                  "../common/bin2bcd.sv",
+                  "fsm_multiplier.sv"],
+    },
+    "pwm_modulated_sine": {
+        "dir": "LAB2",
+        "top": "pwm_modulated_sine",
+        "files": ["../common/debouncer.sv",
+                  "quarter_sine.sv",
+                  "sine_bank.sv",
+                  "sigma_delta.sv",
+                  "pwm_modulated_sine.sv"],
+    },
+    "snake_game": {
+        "dir": "Final Project/finalprojectComplete/Project - Code",
+        "top": "DE10_Lite_Snake",
+        "files": ["snake_pkg.sv",
+                  "dual_port_ram.sv",
+                  "../../../common/bin2bcd.sv",
+                  "pixel_pll.sv",
+                  "vga_controller.sv",
+                  "sprite_rom.sv",
+                  "font_rom.sv",
+                  "text_overlay.sv",
+                  "text_writer.sv",
+                  "snake_renderer.sv",
+                  "snake_display.sv",
+                  "apple_placer.sv",
+                  "snake_pathfinder.sv",
+                  "turn_queue.sv",
+                  "latency_stats.sv",
+                  "perf_counters.sv",
+                  "snake_control.sv",
+                  "../../../common/debouncer.sv",
+                  "snake_game.sv",
+                  "sdram_ctrl.sv",
+                  "snake_world.sv",
+                  "DE10_Lite_Snake.sv"],
+        "altpll": True,
+    },
+    "snake_game_top": {
+        "dir": "Final Project/project1",
+        "top": "snake_game_top",
+        "files": ["../../common/debouncer.sv",
+                  "vga_pll.v",
+                  "video_sync_generator.v",
+                  "gridalizer.v",
+                  "apple_generator.v",
+                  "directionizer.v",
+                  "pulser.v",
+                  "vga_rectangle.v",
+                  "snake_ram.v",
+                  "snake_game_top.v"],
+        "altpll": True,
+    },
+}
+
+METRICS = ["luts", "ffs", "memory_bits", "m9k", "multipliers", "lut_depth"]
+
+FF_PREFIXES = ("$_DFF", "$_SDFF", "$_ALDFF", "$_DLATCH", "$_SR_")
+
+
+def yosys_script(design, out):
+    """Yosys script for one design; paths relative to the design's dir."""
+    cwd = os.path.join(REPO_DIR, design["dir"])
+
+    def rel(path):
+        return os.path.relpath(path, cwd)
+
+    files = list(design["files"])
+    if design.get("altpll"):
+        files.insert(0, rel(ALTPLL_STUB))
+
+    top = design["top"]
+    return "\n".join([
+        "read_slang --top %s %s" % (top, " ".join(files)),
+        # Coarse: memories and multipliers are still whole cells here.
+        "synth -flatten -top %s -run begin:fine" % top,
+        "tee -q -o %s stat -json" % rel(out + ".coarse.json"),
+        "memory_bram -rules %s" % rel(M9K_RULES),
+        "opt -fast -full",
+        "memory_map",
+        "opt -full",
+        "techmap",
+        "opt -fast",
+        "abc -lut 4",
+        "opt -fast",
+        "tee -q -o %s stat -json" % rel(out + ".mapped.json"),
+        "tee -q -o %s ltp -noff" % rel(out + ".ltp.txt"),
+        "",
+    ]), cwd
+
+
+def read_stat(path, top):
+    """Top-level numbers from a `stat -json` dump."""
+    with open(path) as f:
+        text = f.read()
+    data, _ = json.JSONDecoder().raw_decode(text[text.index("{"):])
+    if "design" in data:
+        return data["design"]
+    return data["modules"]["\\" + top]
+
+
+def synthesize(name):
+    design = DESIGNS[name]
+    out = os.path.join(OUT_DIR, name)
+    script, cwd = yosys_script(design, out)
+    with open(out + ".ys", "w") as f:
+        f.write(script)
+
+    result = subprocess.run(["yosys", "-m", "slang", "-q", "-l", out + ".log",
+                             "-s", out + ".ys"],
+                            cwd=cwd, stdout=subprocess.DEVNULL,
+                            stderr=subprocess.STDOUT)
+    if result.returncode != 0:
+        sys.exit("%s: yosys failed, see %s" % (name, out + ".log"))
+
+    coarse = read_stat(out + ".coarse.json", design["top"])
+    mapped = read_stat(out + ".mapped.json", design["top"])
+    coarse_cells = coarse.get("num_cells_by_type", {})
+    mapped_cells = mapped.get("num_cells_by_type", {})
+
+    with open(out + ".ltp.txt") as f:
+        depth = re.search(r"length=(\d+)", f.read())
+
+    return {
+        "luts": mapped_cells.get("$lut", 0),
+        "ffs": sum(n for cell, n in mapped_cells.items()
+                   if cell.startswith(FF_PREFIXES)),
+        "memory_bits": coarse.get("num_memory_bits", 0),
+        "m9k": mapped_cells.get("$__M9K", 0),
+        "multipliers": sum(n for cell, n in coarse_cells.items()
+                           if cell in ("$mul", "$macc", "$macc_v2")),
+        "lut_depth": int(depth.group(1)) if depth else 0,
+    }
+
+
+def yosys_version():
+    result = subprocess.run(["yosys", "-V"], capture_output=True, text=True)
+    return result.stdout.strip()
+
+
+def print_table(results, baseline):
+    print("%-20s" % "design" + "".join("%13s" % m for m in METRICS))
+    for name, metrics in results.items():
+        base = baseline.get(name, {})
+        cells = []
+        for m in METRICS:
+            cell = str(metrics[m])
+            if m in base and base[m] != metrics[m]:
+                cell += "(%+d)" % (metrics[m] - base[m])
+            cells.append("%13s" % cell)
+        print("%-20s" % name + "".join(cells))
+
+
+def regressions(results, baseline, threshold):
+    failed = []
+    for name, metrics in results.items():
+        if name not in baseline:
+            failed.append("%s: no baseline, run `make baseline`" % name)
+            continue
+        for m in METRICS:
+            base = baseline[name].get(m, 0)
+            allowed = max(base * threshold / 100.0, 1)
+            if metrics[m] - base > allowed:
+                failed.append("%s: %s %d -> %d" % (name, m, base, metrics[m]))
+    return failed
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("mode", choices=["run", "baseline"])
+    parser.add_argument("-d", "--design", action="append", choices=list(DESIGNS),
+                        help="design to synthesize (default: all)")
+    parser.add_argument("-t", "--threshold", type=float, default=5.0,
+                        help="allowed growth per metric, percent (default 5)")
+    args = parser.parse_args()
+
+    os.makedirs(OUT_DIR, exist_ok=True)
+    version = yosys_version()
+    results = {name: synthesize(name) for name in (args.design or DESIGNS)}
+
+    saved = {"yosys": version, "designs": {}}
+    if os.path.exists(BASELINE):
+        with open(BASELINE) as f:
+            saved = json.load(f)
+
+    if args.mode == "baseline":
+        saved["yosys"] = version
+        saved["designs"].update(results)
+        with open(BASELINE, "w") as f:
+            json.dump(saved, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print_table(results, {})
+        print("wrote %s" % os.path.relpath(BASELINE))
+        return
+
+    if saved["yosys"] != version:
+        print("baseline from %s, running %s" % (saved["yosys"], version))
+    print_table(results, saved["designs"])
+    failed = regressions(results, saved["designs"], args.threshold)
+    for line in failed:
+        print("REGRESSION " + line)
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
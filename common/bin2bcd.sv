@@ -0,0 +1,101 @@
+// Binary to BCD converter (double dabble: for each input bit, MSB first,
+// add 3 to every digit of 5 or more, then shift the bit in).
+//
+// Two builds, chosen by PIPELINED:
+//   0 - iterative: one bit per clock through a single row of digit
+//       adjusters. start is taken when idle; valid pulses WIDTH + 1
+//       clocks later. A few dozen LEs whatever the width.
+//   1 - pipelined: WIDTH register stages, one bit each, and the output
+//       register. A new value can start every clock; each comes out
+//       WIDTH + 1 clocks later with valid.
+// bcd holds the last result, least significant digit in bcd[3:0]. Values
+// of 10**DIGITS or more lose their top digits.
+module bin2bcd #(
+    parameter WIDTH = 16,                            // Binary input width
+    parameter DIGITS = 5,                            // BCD digits out
+    parameter PIPELINED = 0
+)(
+    input  logic clk,
+    input  logic reset_n,
+    input  logic start,                              // Convert bin (iterative: when !busy)
+    input  logic [WIDTH-1:0] bin,
+    output logic busy,                               // Iterative conversion running (0 when PIPELINED)
+    output logic valid,                              // bcd updated this clock
+    output logic [4*DIGITS-1:0] bcd
+);
+
+    // One double dabble step: correct the digits, then shift in b
+    function automatic logic [4*DIGITS-1:0] dabble(input logic [4*DIGITS-1:0] d, input logic b);
+        for (int i = 0; i < DIGITS; i++)
+            if (d[4*i +: 4] >= 5)
+                d[4*i +: 4] = d[4*i +: 4] + 4'd3;
+        return {d[4*DIGITS-2:0], b};
+    endfunction
+
+    generate
+        if (PIPELINED) begin : pipelined
+            // Stage s holds the digits after s bits and the bits still to go
+            logic [4*DIGITS-1:0] digits [1:WIDTH];
+            logic [WIDTH-1:0] rest [1:WIDTH];
+            logic [WIDTH:1] stage_valid;
+
+            assign busy = 1'b0;
+
+            always_ff @(posedge clk or negedge reset_n) begin
+                if (~reset_n) begin
+                    stage_valid <= '0;
+                    bcd <= '0;
+                    valid <= 1'b0;
+                    for (int s = 1; s <= WIDTH; s++) begin
+                        digits[s] <= '0;
+                        rest[s] <= '0;
+                    end
+                end else begin
+                    stage_valid <= {stage_valid[WIDTH-1:1], start};
+                    digits[1] <= dabble('0, bin[WIDTH-1]);
+                    rest[1] <= bin << 1;
+                    for (int s = 2; s <= WIDTH; s++) begin
+                        digits[s] <= dabble(digits[s-1], rest[s-1][WIDTH-1]);
+                        rest[s] <= rest[s-1] << 1;
+                    end
+                    valid <= stage_valid[WIDTH];
+                    if (stage_valid[WIDTH])
+                        bcd <= digits[WIDTH];
+                end
+            end
+        end else begin : iterative
+            logic [4*DIGITS-1:0] digits;
+            logic [WIDTH-1:0] rest;
+            localparam COUNT_BITS = $clog2(WIDTH + 1);
+            logic [COUNT_BITS-1:0] bits_left;
+
+            assign busy = bits_left != 0;
+
+            always_ff @(posedge clk or negedge reset_n) begin
+                if (~reset_n) begin
+                    digits <= '0;
+                    rest <= '0;
+                    bits_left <= 0;
+                    bcd <= '0;
+                    valid <= 1'b0;
+                end else begin
+                    valid <= 1'b0;
+                    if (busy) begin
+                        digits <= dabble(digits, rest[WIDTH-1]);
+                        rest <= rest << 1;
+                        bits_left <= bits_left - 1'b1;
+                        if (bits_left == 1) begin
+                            bcd <= dabble(digits, rest[WIDTH-1]);
+                            valid <= 1'b1;
+                        end
+                    end else if (start) begin
+                        digits <= '0;
+                        rest <= bin;
+                        bits_left <= COUNT_BITS'(WIDTH);
+                    end
+                end
+            end
+        end
+    endgenerate
+
+endmodule
@@ -0,0 +1,160 @@
+// Both builds of bin2bcd against / and %, for every WIDTH-bit value.
+//
+// The iterative build converts one value at a time (start, then wait for
+// valid) and must answer exactly WIDTH + 1 clocks after start. The
+// pipelined build is given a new value every clock; results must come out
+// in order, WIDTH + 1 clocks after their start, one per clock.
+module bin2bcd_tb #(
+    parameter WIDTH = 13,                            // As text_writer uses it
+    parameter DIGITS = 4
+)();
+    localparam LATENCY = WIDTH + 1;
+    localparam COUNT = 1 << WIDTH;
+
+    logic clk;
+    logic reset_n;
+
+    logic iter_start, iter_busy, iter_valid;
+    logic [WIDTH-1:0] iter_bin;
+    logic [4*DIGITS-1:0] iter_bcd;
+
+    logic pipe_start, pipe_busy, pipe_valid;
+    logic [WIDTH-1:0] pipe_bin;
+    logic [4*DIGITS-1:0] pipe_bcd;
+
+    bin2bcd #(
+        .WIDTH(WIDTH),
+        .DIGITS(DIGITS),
+        .PIPELINED(0)
+    ) iter_dut (
+        .clk(clk),
+        .reset_n(reset_n),
+        .start(iter_start),
+        .bin(iter_bin),
+        .busy(iter_busy),
+        .valid(iter_valid),
+        .bcd(iter_bcd)
+    );
+
+    bin2bcd #(
+        .WIDTH(WIDTH),
+        .DIGITS(DIGITS),
+        .PIPELINED(1)
+    ) pipe_dut (
+        .clk(clk),
+        .reset_n(reset_n),
+        .start(pipe_start),
+        .bin(pipe_bin),
+        .busy(pipe_busy),
+        .valid(pipe_valid),
+        .bcd(pipe_bcd)
+    );
+
+    // Clock generation
+    initial begin
+        clk = 0;
+        forever #10 clk = ~clk; // 50MHz clock
+    end
+
+    // Reference conversion
+    function automatic logic [4*DIGITS-1:0] to_bcd(input int value);
+        logic [4*DIGITS-1:0] d;
+        for (int i = 0; i < DIGITS; i++) begin
+            d[4*i +: 4] = 4'(value % 10);
+            value = value / 10;
+        end
+        return d;
+    endfunction
+
+    int errors = 0;
+    int cycle = 0;                                   // Rising clock edges since time 0
+    logic iter_done = 0;
+
+    always @(posedge clk)
+        cycle++;
+
+    // Iterative build, one value at a time
+    initial begin : iterative
+        int latency;
+
+        iter_start = 0;
+        iter_bin = 0;
+        wait (reset_n);
+        for (int v = 0; v < COUNT; v++) begin
+            @(negedge clk);
+            iter_bin = WIDTH'(v);
+            iter_start = 1;
+            @(negedge clk);
+            iter_start = 0;
+            iter_bin = '0;
+            latency = 1;
+            while (!iter_valid && latency < 2 * LATENCY) begin
+                @(negedge clk);
+                latency++;
+            end
+            if (latency != LATENCY || iter_bcd != to_bcd(v)) begin
+                errors++;
+                $display("iterative: %0d gave %h after %0d clocks, expected %h after %0d",
+                         v, iter_bcd, latency, to_bcd(v), LATENCY);
+            end
+        end
+        iter_done = 1;
+    end
+
+    // Pipelined build, value v started on clock first_cycle + v; its
+    // result is due LATENCY clocks later
+    int first_cycle = 0;
+    int pipe_seen = 0;
+
+    initial begin : pipelined
+        pipe_start = 0;
+        pipe_bin = 0;
+        wait (reset_n);
+        @(negedge clk);
+        first_cycle = cycle;
+        for (int v = 0; v < COUNT; v++) begin
+            pipe_bin = WIDTH'(v);
+            pipe_start = 1;
+            @(negedge clk);
+        end
+        pipe_start = 0;
+    end
+
+    always @(negedge clk) begin
+        if (reset_n && pipe_valid) begin
+            if (pipe_bcd != to_bcd(pipe_seen) || cycle != first_cycle + pipe_seen + LATENCY) begin
+                errors++;
+                $display("pipelined: %0d gave %h after %0d clocks, expected %h after %0d",
+                         pipe_seen, pipe_bcd, cycle - first_cycle - pipe_seen, to_bcd(pipe_seen),
+                         LATENCY);
+            end
+            pipe_seen++;
+        end
+    end
+
+    // Test sequence
+    initial begin
+        reset_n = 0;
+        repeat (4) @(posedge clk);
+        @(negedge clk) reset_n = 1;
+
+        // The iterative sweep is much the longer of the two
+        wait (iter_done);
+        repeat (4) @(posedge clk);
+
+        if (pipe_busy || iter_busy) begin
+            errors++;
+            $display("busy still set at the end");
+        end
+        if (pipe_seen != COUNT) begin
+            errors++;
+            $display("pipelined: %0d results for %0d values", pipe_seen, COUNT);
+        end
+
+        $display("bin2bcd: %0d values, %0d errors", COUNT, errors);
+        if (errors != 0)
+            $error("bin2bcd_tb FAILED");
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,104 @@
+// Debouncer for N push buttons or switches.
+//
+// Each input is synchronized with two flip-flops and then sampled at
+// SAMPLE_HZ by one prescaler shared by all inputs. A per-input up/down
+// integrator of INTEG_BITS bits counts towards the sampled level. The
+// debounced level goes high when the integrator reaches its top and low
+// when it reaches zero, so a bouncing contact never toggles it. With the
+// defaults a clean press is seen after 16 samples, 16 ms.
+//
+// The shared prescaler is the only wide counter. Each extra input costs
+// INTEG_BITS + 6 flip-flops (synchronizer, integrator, level, its delayed
+// copy, rise and fall), not a counter of its own.
+//
+// SIM_SPEEDUP divides the sample period (down to one clock), so a
+// testbench with the same factor can hold a key for 16 ms / SIM_SPEEDUP.
+//
+// Outputs, per input:
+//   level - debounced level
+//   rise  - one-clock pulse when level goes high
+//   fall  - one-clock pulse when level goes low
+module debouncer #(
+    parameter N = 2,                                 // Number of inputs
+    parameter CLK_HZ = 50_000_000,
+    parameter SAMPLE_HZ = 1_000,                     // Integrator sample rate
+    parameter INTEG_BITS = 4,                        // Samples to settle: 2**INTEG_BITS
+    parameter SIM_SPEEDUP = 1                        // Simulation only: time constants / SIM_SPEEDUP
+)(
+    input  logic clk,
+    input  logic rst,                                // Asynchronous, active high
+    input  logic [N-1:0] in,                         // Raw inputs, active high
+    output logic [N-1:0] level,
+    output logic [N-1:0] rise,
+    output logic [N-1:0] fall
+);
+
+    localparam DIV_SCALED = CLK_HZ / SAMPLE_HZ / SIM_SPEEDUP;
+    localparam DIV = (DIV_SCALED > 1) ? DIV_SCALED : 1;
+    localparam DIV_BITS = (DIV > 1) ? $clog2(DIV) : 1;
+    localparam logic [DIV_BITS-1:0] DIV_LAST = DIV_BITS'(DIV - 1);
+
+    // Synchronizer
+    logic [N-1:0] sync1, sync2;
+
+    always_ff @(posedge clk or posedge rst) begin
+        if (rst) begin
+            sync1 <= '0;
+            sync2 <= '0;
+        end else begin
+            sync1 <= in;
+            sync2 <= sync1;
+        end
+    end
+
+    // Shared sample-rate prescaler
+    logic [DIV_BITS-1:0] prescale;
+    logic sample;
+
+    always_ff @(posedge clk or posedge rst) begin
+        if (rst) begin
+            prescale <= '0;
+            sample <= 1'b0;
+        end else begin
+            sample <= prescale == DIV_LAST;
+            prescale <= (prescale == DIV_LAST) ? '0 : prescale + 1'b1;
+        end
+    end
+
+    // Per-input integrators and edge detection
+    logic [INTEG_BITS-1:0] integ [0:N-1];
+    logic [N-1:0] level_d;
+
+    always_ff @(posedge clk or posedge rst) begin
+        if (rst) begin
+            for (int i = 0; i < N; i++)
+                integ[i] <= '0;
+            level <= '0;
+        end else if (sample) begin
+            for (int i = 0; i < N; i++) begin
+                if (sync2[i] && integ[i] != '1)
+                    integ[i] <= integ[i] + 1'b1;
+                else if (!sync2[i] && integ[i] != '0)
+                    integ[i] <= integ[i] - 1'b1;
+
+                if (integ[i] == '1)
+                    level[i] <= 1'b1;
+                else if (integ[i] == '0)
+                    level[i] <= 1'b0;
+            end
+        end
+    end
+
+    always_ff @(posedge clk or posedge rst) begin
+        if (rst) begin
+            level_d <= '0;
+            rise <= '0;
+            fall <= '0;
+        end else begin
+            level_d <= level;
+            rise <= level & ~level_d;
+            fall <= ~level & level_d;
+        end
+    end
+
+endmodule